@@ -33,6 +33,7 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/templates/a_hash_map.h"
+#include "core/templates/swiss_hash_map.h"
 
 /**
 	A* pathfinding algorithm.
@@ -110,7 +111,7 @@ class AStar3D : public RefCounted {
 	mutable int64_t last_free_id = 0;
 	uint64_t pass = 1;
 
-	AHashMap<int64_t, Point *> points;
+	SwissHashMap<int64_t, Point *> points;
 	HashSet<Segment, Segment> segments;
 	Point *last_closest_point = nullptr;
 	bool neighbor_filter_enabled = false;
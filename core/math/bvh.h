@@ -53,6 +53,7 @@
 #include "bvh_tree.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -72,6 +73,13 @@ public:
 		_thread_safe = p_enable;
 	}
 
+	// Culls the changed items on the WorkerThreadPool when checking for collisions, for trees with many moving items.
+	// The pair callbacks are still sent from the calling thread, in the same order.
+	// Checks done from a WorkerThreadPool thread always stay on that thread.
+	void params_set_parallel_collision_check(bool p_enable) {
+		_parallel_collision_check = p_enable;
+	}
+
 	// these 2 are crucial for fine tuning, and can be applied manually
 	// see the variable declarations for more info.
 	void params_set_node_expansion(real_t p_value) {
@@ -436,6 +444,12 @@ private:
 			return;
 		}
 
+		// Pool threads (such as a server pump task) can't block on a group, its tasks might never get a thread.
+		if (_parallel_collision_check && changed_items.size() >= PARALLEL_COLLISION_CHECK_MIN_ITEMS && WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+			_check_for_collisions_parallel(p_full_check);
+			return;
+		}
+
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -479,6 +493,51 @@ private:
 		_reset();
 	}
 
+	// Same as above, but with the culls (which only read the tree) done in parallel beforehand.
+	// Pairing doesn't affect the culls, so applying the results in the order of the changed items
+	// sends exactly the same callbacks as the serial version, whatever the scheduling.
+	void _check_for_collisions_parallel(bool p_full_check) {
+		_changed_item_hits.resize(changed_items.size());
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_changed_item, nullptr, changed_items.size(), -1, true, SNAME("BVHCollisionCheck"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = 0; i < changed_items.size(); i++) {
+			const BVHHandle &h = changed_items[i];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+			_find_leavers(h, abb, p_full_check);
+
+			uint32_t changed_item_ref_id = h.id();
+
+			for (const uint32_t ref_id : _changed_item_hits[i]) {
+				if (ref_id == changed_item_ref_id) {
+					continue;
+				}
+
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
+	void _cull_changed_item(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_concurrent(params, _changed_item_hits[p_index]);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -772,6 +831,12 @@ private:
 	LocalVector<BVHHandle> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Below this many changed items, the parallel collision check isn't worth the task overhead.
+	static constexpr uint32_t PARALLEL_COLLISION_CHECK_MIN_ITEMS = 256;
+	bool _parallel_collision_check = false;
+	// Cull hits of each changed item, kept between checks to reuse the allocations.
+	LocalVector<LocalVector<uint32_t>> _changed_item_hits;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
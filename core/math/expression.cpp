@@ -31,6 +31,7 @@
 #include "expression.h"
 
 #include "core/object/class_db.h"
+#include "core/templates/small_vector.h"
 
 Error Expression::_get_token(Token &r_token) {
 	while (true) {
@@ -1369,8 +1370,8 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 		case Expression::ENode::TYPE_CONSTRUCTOR: {
 			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
+			SmallVector<Variant, 4> arr;
+			SmallVector<const Variant *, 4> argp;
 			arr.resize(constructor->arguments.size());
 			argp.resize(constructor->arguments.size());
 
@@ -1381,8 +1382,8 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 				if (ret) {
 					return true;
 				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+				arr.set(i, value);
+				argp.set(i, &arr[i]);
 			}
 
 			Callable::CallError ce;
@@ -1397,8 +1398,8 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 		case Expression::ENode::TYPE_BUILTIN_FUNC: {
 			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
+			SmallVector<Variant, 4> arr;
+			SmallVector<const Variant *, 4> argp;
 			arr.resize(bifunc->arguments.size());
 			argp.resize(bifunc->arguments.size());
 
@@ -1408,8 +1409,8 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 				if (ret) {
 					return true;
 				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+				arr.set(i, value);
+				argp.set(i, &arr[i]);
 			}
 
 			r_ret = Variant(); //may not return anything
@@ -1431,8 +1432,8 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 				return true;
 			}
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
+			SmallVector<Variant, 4> arr;
+			SmallVector<const Variant *, 4> argp;
 			arr.resize(call->arguments.size());
 			argp.resize(call->arguments.size());
 
@@ -1443,8 +1444,8 @@ bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression:
 				if (ret) {
 					return true;
 				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
+				arr.set(i, value);
+				argp.set(i, &arr[i]);
 			}
 
 			Callable::CallError ce;
@@ -0,0 +1,262 @@
+/**************************************************************************/
+/*  packed_math.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "packed_math.h"
+
+// SSE2 is part of the x86_64 baseline, so the vectorized paths are selected at
+// compile time. Other targets use the scalar loops, which compilers are free to
+// auto-vectorize.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PACKED_MATH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace PackedMath {
+
+template <typename T>
+static _ALWAYS_INLINE_ T *_stride(T *p_ptr, size_t p_bytes) {
+	return reinterpret_cast<T *>(reinterpret_cast<uint8_t *>(p_ptr) + p_bytes);
+}
+
+template <typename T>
+static _ALWAYS_INLINE_ const T *_stride(const T *p_ptr, size_t p_bytes) {
+	return reinterpret_cast<const T *>(reinterpret_cast<const uint8_t *>(p_ptr) + p_bytes);
+}
+
+#if defined(PACKED_MATH_SSE2) && !defined(REAL_T_IS_DOUBLE)
+#define PACKED_MATH_SSE2_VECTOR3
+
+// Vector3 is 12 bytes, so load and store it in two parts to never touch memory past its end.
+static _ALWAYS_INLINE_ __m128 _load_vector3(const Vector3 *p_src) {
+	const float *src = &p_src->x;
+	return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(src)), _mm_load_ss(src + 2));
+}
+
+static _ALWAYS_INLINE_ void _store_vector3(Vector3 *p_dst, __m128 p_value) {
+	float *dst = &p_dst->x;
+	_mm_storel_pi(reinterpret_cast<__m64 *>(dst), p_value);
+	_mm_store_ss(dst + 2, _mm_movehl_ps(p_value, p_value));
+}
+
+enum TransformKind {
+	TRANSFORM_POINTS,
+	TRANSFORM_VECTORS,
+	TRANSFORM_POINTS_INVERSE,
+};
+
+// Adds and multiplies in the same order as `Transform3D::xform()`, `Basis::xform()` and `Transform3D::xform_inv()`,
+// so the results are bit-identical to transforming each element with them. Vectors don't add a zero origin, since
+// that would turn -0.0 into 0.0.
+template <TransformKind Kind>
+static _ALWAYS_INLINE_ void _transform_sse2(const Basis &p_basis, const Vector3 &p_origin, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count, size_t p_src_stride, size_t p_dst_stride) {
+	// The inverse multiplies by the transposed basis, whose columns are the rows of the basis.
+	const __m128 axis_x = Kind == TRANSFORM_POINTS_INVERSE ? _mm_setr_ps(p_basis.rows[0][0], p_basis.rows[0][1], p_basis.rows[0][2], 0.0f) : _mm_setr_ps(p_basis.rows[0][0], p_basis.rows[1][0], p_basis.rows[2][0], 0.0f);
+	const __m128 axis_y = Kind == TRANSFORM_POINTS_INVERSE ? _mm_setr_ps(p_basis.rows[1][0], p_basis.rows[1][1], p_basis.rows[1][2], 0.0f) : _mm_setr_ps(p_basis.rows[0][1], p_basis.rows[1][1], p_basis.rows[2][1], 0.0f);
+	const __m128 axis_z = Kind == TRANSFORM_POINTS_INVERSE ? _mm_setr_ps(p_basis.rows[2][0], p_basis.rows[2][1], p_basis.rows[2][2], 0.0f) : _mm_setr_ps(p_basis.rows[0][2], p_basis.rows[1][2], p_basis.rows[2][2], 0.0f);
+	const __m128 origin = _mm_setr_ps(p_origin.x, p_origin.y, p_origin.z, 0.0f);
+
+	for (int64_t i = 0; i < p_count; i++) {
+		__m128 v = _load_vector3(p_src);
+		if constexpr (Kind == TRANSFORM_POINTS_INVERSE) {
+			v = _mm_sub_ps(v, origin);
+		}
+		__m128 r = _mm_mul_ps(axis_x, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = _mm_add_ps(r, _mm_mul_ps(axis_y, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+		r = _mm_add_ps(r, _mm_mul_ps(axis_z, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+		if constexpr (Kind == TRANSFORM_POINTS) {
+			r = _mm_add_ps(r, origin);
+		}
+		_store_vector3(p_dst, r);
+
+		p_src = _stride(p_src, p_src_stride);
+		p_dst = _stride(p_dst, p_dst_stride);
+	}
+}
+#endif
+
+void transform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count, size_t p_src_stride, size_t p_dst_stride) {
+#ifdef PACKED_MATH_SSE2_VECTOR3
+	_transform_sse2<TRANSFORM_POINTS>(p_xform.basis, p_xform.origin, p_src, p_dst, p_count, p_src_stride, p_dst_stride);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		*p_dst = p_xform.xform(*p_src);
+		p_src = _stride(p_src, p_src_stride);
+		p_dst = _stride(p_dst, p_dst_stride);
+	}
+#endif
+}
+
+void inverse_transform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count, size_t p_src_stride, size_t p_dst_stride) {
+#ifdef PACKED_MATH_SSE2_VECTOR3
+	_transform_sse2<TRANSFORM_POINTS_INVERSE>(p_xform.basis, p_xform.origin, p_src, p_dst, p_count, p_src_stride, p_dst_stride);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		*p_dst = p_xform.xform_inv(*p_src);
+		p_src = _stride(p_src, p_src_stride);
+		p_dst = _stride(p_dst, p_dst_stride);
+	}
+#endif
+}
+
+void transform_vectors(const Basis &p_basis, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count, size_t p_src_stride, size_t p_dst_stride) {
+#ifdef PACKED_MATH_SSE2_VECTOR3
+	_transform_sse2<TRANSFORM_VECTORS>(p_basis, Vector3(), p_src, p_dst, p_count, p_src_stride, p_dst_stride);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		*p_dst = p_basis.xform(*p_src);
+		p_src = _stride(p_src, p_src_stride);
+		p_dst = _stride(p_dst, p_dst_stride);
+	}
+#endif
+}
+
+void dot(const Vector3 *p_src, const Vector3 &p_with, real_t *p_dst, int64_t p_count, size_t p_src_stride) {
+	for (int64_t i = 0; i < p_count; i++) {
+		p_dst[i] = p_with.dot(*p_src);
+		p_src = _stride(p_src, p_src_stride);
+	}
+}
+
+AABB compute_aabb(const Vector3 *p_src, int64_t p_count, size_t p_src_stride) {
+	if (p_count <= 0) {
+		return AABB();
+	}
+
+#ifdef PACKED_MATH_SSE2_VECTOR3
+	__m128 begin = _load_vector3(p_src);
+	__m128 end = begin;
+	for (int64_t i = 1; i < p_count; i++) {
+		p_src = _stride(p_src, p_src_stride);
+		const __m128 v = _load_vector3(p_src);
+		begin = _mm_min_ps(begin, v);
+		end = _mm_max_ps(end, v);
+	}
+
+	Vector3 position;
+	Vector3 size;
+	_store_vector3(&position, begin);
+	_store_vector3(&size, _mm_sub_ps(end, begin));
+	return AABB(position, size);
+#else
+	Vector3 begin = *p_src;
+	Vector3 end = begin;
+	for (int64_t i = 1; i < p_count; i++) {
+		p_src = _stride(p_src, p_src_stride);
+		begin = begin.min(*p_src);
+		end = end.max(*p_src);
+	}
+	return AABB(begin, end - begin);
+#endif
+}
+
+void lerp(const float *p_from, const float *p_to, float p_weight, float *p_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SSE2
+	const __m128 weight = _mm_set1_ps(p_weight);
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 from = _mm_loadu_ps(p_from + i);
+		const __m128 to = _mm_loadu_ps(p_to + i);
+		_mm_storeu_ps(p_dst + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), weight)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = Math::lerp(p_from[i], p_to[i], p_weight);
+	}
+}
+
+void lerp(const double *p_from, const double *p_to, double p_weight, double *p_dst, int64_t p_count) {
+	int64_t i = 0;
+#ifdef PACKED_MATH_SSE2
+	const __m128d weight = _mm_set1_pd(p_weight);
+	for (; i + 2 <= p_count; i += 2) {
+		const __m128d from = _mm_loadu_pd(p_from + i);
+		const __m128d to = _mm_loadu_pd(p_to + i);
+		_mm_storeu_pd(p_dst + i, _mm_add_pd(from, _mm_mul_pd(_mm_sub_pd(to, from), weight)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = Math::lerp(p_from[i], p_to[i], p_weight);
+	}
+}
+
+float dot(const float *p_a, const float *p_b, int64_t p_count) {
+	int64_t i = 0;
+	float sum = 0.0f;
+#ifdef PACKED_MATH_SSE2
+	__m128 acc = _mm_setzero_ps();
+	for (; i + 4 <= p_count; i += 4) {
+		acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(p_a + i), _mm_loadu_ps(p_b + i)));
+	}
+	acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+	acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
+	sum = _mm_cvtss_f32(acc);
+#endif
+	for (; i < p_count; i++) {
+		sum += p_a[i] * p_b[i];
+	}
+	return sum;
+}
+
+bool min_max(const float *p_src, int64_t p_count, float &r_min, float &r_max) {
+	if (p_count <= 0) {
+		return false;
+	}
+
+	int64_t i = 1;
+	float min = p_src[0];
+	float max = p_src[0];
+#ifdef PACKED_MATH_SSE2
+	if (p_count >= 4) {
+		__m128 vmin = _mm_loadu_ps(p_src);
+		__m128 vmax = vmin;
+		for (i = 4; i + 4 <= p_count; i += 4) {
+			const __m128 v = _mm_loadu_ps(p_src + i);
+			vmin = _mm_min_ps(vmin, v);
+			vmax = _mm_max_ps(vmax, v);
+		}
+		vmin = _mm_min_ps(vmin, _mm_movehl_ps(vmin, vmin));
+		vmin = _mm_min_ss(vmin, _mm_shuffle_ps(vmin, vmin, _MM_SHUFFLE(1, 1, 1, 1)));
+		vmax = _mm_max_ps(vmax, _mm_movehl_ps(vmax, vmax));
+		vmax = _mm_max_ss(vmax, _mm_shuffle_ps(vmax, vmax, _MM_SHUFFLE(1, 1, 1, 1)));
+		min = _mm_cvtss_f32(vmin);
+		max = _mm_cvtss_f32(vmax);
+	}
+#endif
+	for (; i < p_count; i++) {
+		min = MIN(min, p_src[i]);
+		max = MAX(max, p_src[i]);
+	}
+
+	r_min = min;
+	r_max = max;
+	return true;
+}
+
+} // namespace PackedMath
@@ -0,0 +1,62 @@
+/**************************************************************************/
+/*  packed_math.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/aabb.h"
+#include "core/math/transform_3d.h"
+
+// Bulk math kernels over contiguous or strided arrays of floats and vectors.
+// These back the math methods of the packed array types, and are meant to be
+// called directly by engine code that processes vertex or particle buffers.
+//
+// Vector3 kernels take byte strides so they can operate on a member of an
+// array of structs (e.g. `&vertices[0].vertex`, `sizeof(Vertex)`). Source and
+// destination may alias as long as they have the same layout.
+//
+// Element-wise kernels give the same bits as the scalar math they replace.
+// Reductions over float arrays (`dot()`) sum in several lanes, so their result
+// may differ in the last bits from a sequential loop.
+namespace PackedMath {
+
+// Same as `Transform3D::xform()`, `Transform3D::xform_inv()` and `Basis::xform()` on each element.
+void transform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count, size_t p_src_stride = sizeof(Vector3), size_t p_dst_stride = sizeof(Vector3));
+void inverse_transform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count, size_t p_src_stride = sizeof(Vector3), size_t p_dst_stride = sizeof(Vector3));
+void transform_vectors(const Basis &p_basis, const Vector3 *p_src, Vector3 *p_dst, int64_t p_count, size_t p_src_stride = sizeof(Vector3), size_t p_dst_stride = sizeof(Vector3));
+void dot(const Vector3 *p_src, const Vector3 &p_with, real_t *p_dst, int64_t p_count, size_t p_src_stride = sizeof(Vector3));
+AABB compute_aabb(const Vector3 *p_src, int64_t p_count, size_t p_src_stride = sizeof(Vector3));
+
+void lerp(const float *p_from, const float *p_to, float p_weight, float *p_dst, int64_t p_count);
+void lerp(const double *p_from, const double *p_to, double p_weight, double *p_dst, int64_t p_count);
+float dot(const float *p_a, const float *p_b, int64_t p_count);
+// Returns false, leaving the outputs untouched, if `p_count` is zero.
+bool min_max(const float *p_src, int64_t p_count, float &r_min, float &r_max);
+
+} // namespace PackedMath
@@ -30,6 +30,7 @@
 
 #include "transform_3d.h"
 
+#include "core/math/packed_math.h"
 #include "core/string/ustring.h"
 
 void Transform3D::affine_invert() {
@@ -192,6 +193,20 @@ Transform3D Transform3D::operator*(const Transform3D &p_transform) const {
 	return t;
 }
 
+Vector<Vector3> Transform3D::xform(const Vector<Vector3> &p_array) const {
+	Vector<Vector3> array;
+	array.resize(p_array.size());
+	PackedMath::transform_points(*this, p_array.ptr(), array.ptrw(), p_array.size());
+	return array;
+}
+
+Vector<Vector3> Transform3D::xform_inv(const Vector<Vector3> &p_array) const {
+	Vector<Vector3> array;
+	array.resize(p_array.size());
+	PackedMath::inverse_transform_points(*this, p_array.ptr(), array.ptrw(), p_array.size());
+	return array;
+}
+
 Transform3D::operator String() const {
 	return "[X: " + basis.get_column(0).operator String() +
 			", Y: " + basis.get_column(1).operator String() +
@@ -58,13 +58,150 @@
 		mutex.unlock();                           \
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+static SafeNumeric<uint64_t> call_queue_last_id;
+
+// Caches the thread pages of the last queue this thread pushed to.
+static thread_local uint64_t thread_pages_queue_id = 0;
+static thread_local void *thread_pages_cache = nullptr;
+
+CallQueue::ThreadPages *CallQueue::_get_thread_pages_slow() {
+	if (this == MessageQueue::thread_singleton) {
+		// This thread is the only one pushing to this queue.
+		return nullptr;
+	}
+
+	if (likely(thread_pages_queue_id == queue_id)) {
+		return static_cast<ThreadPages *>(thread_pages_cache);
+	}
+
+	const Thread::ID thread_id = Thread::get_caller_id();
+	ThreadPages *tp = nullptr;
+
+	mutex.lock();
+	for (ThreadPages *E : thread_pages) {
+		if (E->thread_id == thread_id) {
+			tp = E;
+			break;
+		}
+	}
+
+	if (!tp) {
+		if (free_thread_pages.is_empty()) {
+			tp = memnew(ThreadPages);
+		} else {
+			tp = free_thread_pages[free_thread_pages.size() - 1];
+			free_thread_pages.resize(free_thread_pages.size() - 1);
+		}
+		tp->mutex.lock();
+		tp->thread_id = thread_id;
+		tp->max_pages_used = 0;
+		tp->idle_flushes = 0;
+		tp->mutex.unlock();
+
+		thread_pages.push_back(tp);
+	}
+	mutex.unlock();
+
+	thread_pages_queue_id = queue_id;
+	thread_pages_cache = tp;
+	return tp;
+}
+
+uint8_t *CallQueue::_reserve(LocalVector<Page *> &r_pages, LocalVector<uint32_t> &r_page_bytes, uint32_t &r_pages_used, uint32_t p_room_needed) {
+	if (r_pages_used == 0 || (r_page_bytes[r_pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (total_pages_used.increment() > max_pages) {
+			total_pages_used.decrement();
+			return nullptr;
+		}
+		if (r_pages_used == r_pages.size()) {
+			r_pages.push_back(allocator->alloc());
+			r_page_bytes.push_back(0);
+		}
+		r_page_bytes[r_pages_used] = 0;
+		r_pages_used++;
+	}
+
+	uint8_t *buffer_end = &r_pages[r_pages_used - 1]->data[r_page_bytes[r_pages_used - 1]];
+	r_page_bytes[r_pages_used - 1] += p_room_needed;
+	return buffer_end;
+}
+
+uint8_t *CallQueue::_lock_and_reserve(ThreadPages *&r_thread_pages, uint32_t p_room_needed) {
+	if (r_thread_pages) {
+		r_thread_pages->mutex.lock();
+		while (unlikely(r_thread_pages->thread_id != Thread::get_caller_id())) {
+			// Reclaimed while this thread wasn't pushing, get new ones.
+			r_thread_pages->mutex.unlock();
+			thread_pages_queue_id = 0;
+			r_thread_pages = _get_thread_pages_slow();
+			r_thread_pages->mutex.lock();
+		}
+		r_thread_pages->idle_flushes = 0;
+		uint8_t *buffer_end = _reserve(r_thread_pages->pages, r_thread_pages->page_bytes, r_thread_pages->pages_used, p_room_needed);
+		if (buffer_end) {
+			r_thread_pages->max_pages_used = MAX(r_thread_pages->max_pages_used, r_thread_pages->pages_used);
+			r_thread_pages->message_count++;
+			thread_message_count.increment();
+		}
+		return buffer_end;
+	}
+
+	LOCK_MUTEX;
+	return _reserve(pages, page_bytes, pages_used, p_room_needed);
+}
+
+void CallQueue::_unlock(ThreadPages *p_thread_pages) {
+	if (p_thread_pages) {
+		p_thread_pages->mutex.unlock();
+	} else {
+		UNLOCK_MUTEX;
+	}
+}
+
+void CallQueue::_peek_thread_pages(ThreadPages *p_thread_pages) {
+	ThreadPages *tp = p_thread_pages;
+
+	// Skip pages that were filled up, but not the last one, as the thread may still add to it.
+	while (tp->read_page + 1 < tp->pages_used && tp->read_offset >= tp->page_bytes[tp->read_page]) {
+		tp->read_page++;
+		tp->read_offset = 0;
+	}
+
+	tp->has_next = tp->read_page < tp->pages_used && tp->read_offset < tp->page_bytes[tp->read_page];
+	if (tp->has_next) {
+		tp->next_sequence = ((Message *)&tp->pages[tp->read_page]->data[tp->read_offset])->sequence;
+	}
+}
+
+void CallQueue::_reset_thread_pages() {
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < thread_pages.size(); i++) {
+		ThreadPages *tp = thread_pages[i];
+		MutexLock lock(tp->mutex);
+
+		if (tp->message_count == 0) {
+			// Everything was read, so start over from the first page.
+			total_pages_used.sub(tp->pages_used);
+			tp->pages_used = 0;
+			tp->read_page = 0;
+			tp->read_offset = 0;
+			tp->has_next = false;
+
+			if (++tp->idle_flushes >= THREAD_PAGES_MAX_IDLE_FLUSHES) {
+				for (uint32_t j = 0; j < tp->pages.size(); j++) {
+					allocator->free(tp->pages[j]);
+				}
+				tp->pages.clear();
+				tp->page_bytes.clear();
+				tp->thread_id = 0;
+				free_thread_pages.push_back(tp);
+				continue;
+			}
+		}
+
+		thread_pages[kept++] = tp;
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+	thread_pages.resize(kept);
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -88,28 +225,20 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadPages *tp = _get_thread_pages();
+	uint8_t *buffer_end = _lock_and_reserve(tp, room_needed);
+	if (!buffer_end) {
+		_unlock(tp);
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
+	msg->sequence = push_sequence.increment();
 	if (p_show_error) {
 		msg->type |= FLAG_SHOW_ERROR;
 	}
@@ -126,82 +255,65 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_unlock(tp);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	ThreadPages *tp = _get_thread_pages();
+	uint8_t *buffer_end = _lock_and_reserve(tp, room_needed);
+	if (!buffer_end) {
+		_unlock(tp);
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
+	msg->sequence = push_sequence.increment();
 
 	buffer_end += sizeof(Message);
 
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_unlock(tp);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadPages *tp = _get_thread_pages();
+	uint8_t *buffer_end = _lock_and_reserve(tp, room_needed);
+	if (!buffer_end) {
+		_unlock(tp);
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
+	msg->sequence = push_sequence.increment();
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_unlock(tp);
 
 	return OK;
 }
@@ -226,7 +338,7 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
+	if (pages.is_empty() && thread_pages.is_empty()) {
 		// Never allocated
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
@@ -242,20 +354,65 @@ Error CallQueue::flush() {
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	// The oldest message of each thread only changes when it's read, or when it had none and pushed one.
+	// So they are only looked at again once something was pushed since.
+	bool thread_pages_peeked = false;
+	uint32_t peeked_sequence = 0;
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+	while (true) {
+		// Skip pages that were filled up, but not the last one, as a call may still add to it.
+		while (i + 1 < pages_used && offset >= page_bytes[i]) {
+			i++;
+			offset = 0;
+		}
 
-		Message *message = (Message *)&page->data[offset];
+		Message *message = (i < pages_used && offset < page_bytes[i]) ? (Message *)&pages[i]->data[offset] : nullptr;
+
+		// Messages pushed from other threads are interleaved with those of this thread in push order.
+		ThreadPages *from = nullptr;
+		if (thread_message_count.get() > 0) {
+			// Read before peeking. A push taking a sequence number after this gets its pages peeked again.
+			uint32_t sequence = push_sequence.get();
+			if (!thread_pages_peeked || sequence != peeked_sequence) {
+				for (ThreadPages *tp : thread_pages) {
+					MutexLock lock(tp->mutex);
+					_peek_thread_pages(tp);
+				}
+				thread_pages_peeked = true;
+				peeked_sequence = sequence;
+			}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+			for (ThreadPages *tp : thread_pages) {
+				if (tp->has_next && (from ? _is_sequence_before(tp->next_sequence, from->next_sequence) : (!message || _is_sequence_before(tp->next_sequence, message->sequence)))) {
+					from = tp;
+				}
+			}
 		}
 
-		//pre-advance so this function is reentrant
-		offset += advance;
+		if (from) {
+			MutexLock lock(from->mutex);
+			message = (Message *)&from->pages[from->read_page]->data[from->read_offset];
+
+			uint32_t advance = sizeof(Message);
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				advance += sizeof(Variant) * message->args;
+			}
+
+			from->read_offset += advance;
+			from->message_count--;
+			thread_message_count.decrement();
+			_peek_thread_pages(from);
+		} else if (message) {
+			uint32_t advance = sizeof(Message);
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				advance += sizeof(Variant) * message->args;
+			}
+
+			//pre-advance so this function is reentrant
+			offset += advance;
+		} else {
+			break;
+		}
 
 		Object *target = message->callable.get_object();
 
@@ -291,32 +448,26 @@ Error CallQueue::flush() {
 		message->~Message();
 
 		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
-		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	if (pages_used > 0) {
+		total_pages_used.sub(pages_used - 1);
+		page_bytes[0] = 0;
+		pages_used = 1;
+	}
+
+	_reset_thread_pages();
 
 	flushing = false;
 	UNLOCK_MUTEX;
 	return OK;
 }
 
-void CallQueue::clear() {
-	LOCK_MUTEX;
-
-	if (pages.is_empty()) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+void CallQueue::_destroy_messages(const LocalVector<Page *> &p_pages, const LocalVector<uint32_t> &p_page_bytes, uint32_t p_pages_used, uint32_t p_from_page, uint32_t p_from_offset) {
+	for (uint32_t i = p_from_page; i < p_pages_used; i++) {
+		uint32_t offset = i == p_from_page ? p_from_offset : 0;
+		while (offset < p_page_bytes[i]) {
+			Page *page = p_pages[i];
 
 			//lock on each iteration, so a call can re-add itself to the message queue
 
@@ -339,7 +490,31 @@ void CallQueue::clear() {
 			message->~Message();
 		}
 	}
+}
+
+void CallQueue::clear() {
+	LOCK_MUTEX;
+
+	for (ThreadPages *tp : thread_pages) {
+		MutexLock lock(tp->mutex);
+		_destroy_messages(tp->pages, tp->page_bytes, tp->pages_used, tp->read_page, tp->read_offset);
+		thread_message_count.sub(tp->message_count);
+		total_pages_used.sub(tp->pages_used);
+		tp->message_count = 0;
+		tp->pages_used = 0;
+		tp->read_page = 0;
+		tp->read_offset = 0;
+		tp->has_next = false;
+	}
+
+	if (pages.is_empty()) {
+		UNLOCK_MUTEX;
+		return; // Nothing to clear.
+	}
+
+	_destroy_messages(pages, page_bytes, pages_used);
 
+	total_pages_used.sub(pages_used - 1);
 	pages_used = 1;
 	page_bytes[0] = 0;
 
@@ -423,7 +598,11 @@ void CallQueue::statistics() {
 		}
 	}
 
-	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", total_pages_used.get(), total_pages_used.get() * PAGE_SIZE_BYTES);
+	for (ThreadPages *tp : thread_pages) {
+		MutexLock lock(tp->mutex);
+		fprintf(stdout, "THREAD %s PAGES: %d, peak %d (%d bytes allocated).\n", itos(tp->thread_id).utf8().get_data(), tp->pages_used, tp->max_pages_used, tp->pages.size() * PAGE_SIZE_BYTES);
+	}
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -446,6 +625,9 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
+	if (thread_message_count.get() > 0) {
+		return true;
+	}
 	if (pages_used == 0) {
 		return false;
 	}
@@ -457,7 +639,21 @@ bool CallQueue::has_messages() const {
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	LOCK_MUTEX;
+	uint32_t page_count = pages.size();
+	for (ThreadPages *tp : thread_pages) {
+		MutexLock lock(tp->mutex);
+		page_count += tp->pages.size();
+	}
+	UNLOCK_MUTEX;
+	return page_count * PAGE_SIZE_BYTES;
+}
+
+void CallQueue::set_thread_pages_enabled(bool p_enabled) {
+	LOCK_MUTEX;
+	// Messages left in thread pages when disabling them are still run by the next flush.
+	thread_pages_enabled = p_enabled;
+	UNLOCK_MUTEX;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -470,6 +666,7 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 	}
 	max_pages = p_max_pages;
 	error_text = p_error_text;
+	queue_id = call_queue_last_id.increment();
 }
 
 CallQueue::~CallQueue() {
@@ -478,6 +675,15 @@ CallQueue::~CallQueue() {
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
 	}
+	for (ThreadPages *tp : thread_pages) {
+		for (uint32_t i = 0; i < tp->pages.size(); i++) {
+			allocator->free(tp->pages[i]);
+		}
+		memdelete(tp);
+	}
+	for (ThreadPages *tp : free_thread_pages) {
+		memdelete(tp);
+	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
 	}
@@ -509,6 +715,8 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	// Deferred calls from threads (e.g. threaded process groups) get their own pages.
+	set_thread_pages_enabled(true);
 }
 
 MessageQueue::~MessageQueue() {
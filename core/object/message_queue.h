@@ -31,9 +31,11 @@
 #pragma once
 
 #include "core/object/object_id.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -65,7 +67,7 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
-	Mutex mutex;
+	mutable Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
@@ -76,6 +78,42 @@ private:
 	uint32_t pages_used = 0;
 	bool flushing = false;
 
+	// Pages in use by the queue and all its thread pages, which share the max_pages limit.
+	SafeNumeric<uint32_t> total_pages_used;
+	// Stamped on every message, so flush() runs them in push order whichever pages they are in.
+	SafeNumeric<uint32_t> push_sequence;
+
+	// Messages pushed from threads other than the main one, so they don't contend on the queue mutex.
+	// Each set has its own lock, which pushes only share with a flush reading from it.
+	struct ThreadPages {
+		BinaryMutex mutex;
+		Thread::ID thread_id = 0; // 0 once reclaimed, the thread must then get new ones.
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		uint32_t pages_used = 0;
+		uint32_t max_pages_used = 0;
+		uint32_t message_count = 0;
+		uint32_t idle_flushes = 0;
+		// Where flush() reads the next message from. Kept across flushes if messages arrive after the last one.
+		uint32_t read_page = 0;
+		uint32_t read_offset = 0;
+		// Oldest pending message, as last seen by flush(). Only used while flushing.
+		bool has_next = false;
+		uint32_t next_sequence = 0;
+	};
+
+	enum {
+		// Thread pages left empty for this many flushes give their pages back, as their thread may have exited.
+		THREAD_PAGES_MAX_IDLE_FLUSHES = 8
+	};
+
+	bool thread_pages_enabled = false;
+	uint64_t queue_id = 0;
+	LocalVector<ThreadPages *> thread_pages;
+	// Reclaimed thread pages are kept for other threads, since their previous thread may still hold a pointer to them.
+	LocalVector<ThreadPages *> free_thread_pages;
+	SafeNumeric<uint32_t> thread_message_count;
+
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
@@ -87,17 +125,27 @@ private:
 			int16_t notification;
 			int16_t args;
 		};
+		uint32_t sequence; // Fits in the padding.
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
+	_FORCE_INLINE_ static bool _is_sequence_before(uint32_t p_a, uint32_t p_b) {
+		return int32_t(p_a - p_b) < 0; // Wraps around.
+	}
+
+	_FORCE_INLINE_ ThreadPages *_get_thread_pages() {
+		if (likely(!thread_pages_enabled) || Thread::is_main_thread()) {
+			return nullptr;
 		}
+		return _get_thread_pages_slow();
 	}
 
-	void _add_page();
+	ThreadPages *_get_thread_pages_slow();
+	uint8_t *_lock_and_reserve(ThreadPages *&r_thread_pages, uint32_t p_room_needed);
+	void _unlock(ThreadPages *p_thread_pages);
+	uint8_t *_reserve(LocalVector<Page *> &r_pages, LocalVector<uint32_t> &r_page_bytes, uint32_t &r_pages_used, uint32_t p_room_needed);
+	void _destroy_messages(const LocalVector<Page *> &p_pages, const LocalVector<uint32_t> &p_page_bytes, uint32_t p_pages_used, uint32_t p_from_page = 0, uint32_t p_from_offset = 0);
+	void _peek_thread_pages(ThreadPages *p_thread_pages);
+	void _reset_thread_pages();
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -152,6 +200,10 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+protected:
+	void set_thread_pages_enabled(bool p_enabled);
+
+public:
 	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
@@ -1027,6 +1027,8 @@ public:
 	bool is_extension_placeholder() const { return _extension && _extension->is_placeholder; }
 #endif
 
+	_ALWAYS_INLINE_ bool is_extension_instance() const { return _extension != nullptr; }
+
 	void clear_internal_resource_paths();
 
 	_ALWAYS_INLINE_ bool is_ref_counted() const { return _has_ancestry(AncestralClass::REF_COUNTED); }
@@ -1130,3 +1132,24 @@ public:
 	static void debug_objects(DebugFunc p_func, void *p_user_data);
 	static int get_object_count();
 };
+
+#ifdef DEBUG_ENABLED
+
+// Keeps an object from being freed while one of its methods runs. Used by `Object::callp()`
+// and by callers that dispatch straight to a method without going through it.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+
+#endif // DEBUG_ENABLED
@@ -57,6 +57,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
 	Task *prev_task = nullptr; // In case this is recursively called.
+	bool prev_has_pump_task = false;
 
 	bool safe_for_nodes_backup = is_current_thread_safe_for_nodes();
 	CallQueue *call_queue_backup = MessageQueue::get_singleton() != MessageQueue::get_main_singleton() ? MessageQueue::get_singleton() : nullptr;
@@ -72,15 +73,25 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// about to be run uses scripting, guarantees are held.
 		ScriptServer::thread_enter();
 
-		task_mutex.lock();
-		p_task->pool_thread_index = pool_thread_index;
-		prev_task = curr_thread.current_task;
-		curr_thread.current_task = p_task;
-		curr_thread.has_pump_task = p_task->is_pump_task;
-		if (p_task->pending_notify_yield_over) {
-			curr_thread.yield_is_over = true;
+		prev_task = curr_thread.current_task.load(std::memory_order_relaxed);
+		if (p_task->group) {
+			// Group tasks have no ID, so nobody else can look them up. No need to lock.
+			curr_thread.current_task.store(p_task, std::memory_order_release);
+		} else {
+			task_mutex.lock();
+			p_task->pool_thread_index = pool_thread_index;
+			curr_thread.current_task.store(p_task, std::memory_order_release);
+			// Sticks while this task is on the stack, including any tasks it runs while waiting.
+			// Group tasks are never pump tasks, so they leave it alone.
+			prev_has_pump_task = curr_thread.has_pump_task;
+			if (p_task->is_pump_task) {
+				curr_thread.has_pump_task = true;
+			}
+			if (p_task->pending_notify_yield_over) {
+				curr_thread.yield_is_over = true;
+			}
+			task_mutex.unlock();
 		}
-		task_mutex.unlock();
 	}
 #endif
 
@@ -90,12 +101,13 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	if (p_task->group) {
 		// Handling a group
+		Group *group = p_task->group;
 		bool do_post = false;
 
 		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+			uint32_t work_index = group->index.postincrement();
 
-			if (work_index >= p_task->group->max) {
+			if (work_index >= group->max) {
 				break;
 			}
 			if (p_task->native_group_func) {
@@ -107,9 +119,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+			uint32_t completed_amount = group->completed_index.increment();
 
-			if (completed_amount == p_task->group->max) {
+			if (completed_amount == group->max) {
 				do_post = true;
 			}
 		}
@@ -119,22 +131,26 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
+			// Completion is published under the lock, so successors can't be linked to a group that has already released them.
+			MutexLock task_lock(task_mutex);
+			group->completed.set_to(true);
+			_release_successors(group->successor_tasks, group->successor_groups, task_lock);
+			group->done_semaphore.post();
 		}
-		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
-		uint32_t finished_users = p_task->group->finished.increment();
+
+#ifdef THREADS_ENABLED
+		// The task goes away with the group, which may happen as soon as this thread is counted as finished.
+		curr_thread.current_task.store(prev_task, std::memory_order_release);
+#endif
+
+		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
+		uint32_t finished_users = group->finished.increment();
 
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
 			MutexLock task_lock(task_mutex);
-			group_allocator.free(p_task->group);
+			_free_group(group);
 		}
-
-		// For groups, tasks get rid of themselves.
-
-		task_mutex.lock();
-		task_allocator.free(p_task);
 	} else {
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
@@ -145,7 +161,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.call();
 		}
 
-		task_mutex.lock();
+		MutexLock task_lock(task_mutex);
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
 		if (p_task->waiting_user) {
@@ -158,22 +174,24 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+#ifdef THREADS_ENABLED
+		curr_thread.current_task.store(prev_task, std::memory_order_release);
+		curr_thread.has_pump_task = prev_has_pump_task;
+#endif
+		// Done after resetting the current task, so this thread is seen as free to run the successors.
+		_release_successors(p_task->successor_tasks, p_task->successor_groups, task_lock);
 	}
 
 #ifdef THREADS_ENABLED
-	{
-		curr_thread.current_task = prev_task;
-		if (low_priority) {
-			low_priority_threads_used--;
+	if (low_priority) {
+		MutexLock task_lock(task_mutex);
+		low_priority_threads_used--;
 
-			if (_try_promote_low_priority_task()) {
-				if (prev_task) { // Otherwise, this thread will catch it.
-					_notify_threads(&curr_thread, 1, 0);
-				}
+		if (_try_promote_low_priority_task()) {
+			if (prev_task) { // Otherwise, this thread will catch it.
+				_notify_threads(&curr_thread, 1, 0);
 			}
 		}
-
-		task_mutex.unlock();
 	}
 
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
@@ -185,9 +203,16 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
+	{
+		// Threads spawned for pump tasks start while the pool is still registering them.
+		// Tasks taken from the work queues are looked up by thread ID without the lock, so wait for that to be done.
+		MutexLock lock(thread_data->pool->task_mutex);
+	}
+
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: keep taking work from the queues without touching the task mutex.
+		Task *task_to_process = thread_data->pool->_pop_from_work_queues(thread_data);
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -200,6 +225,12 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
+				// Tasks are pushed to the work queues with the lock held, so checking them again now can't miss any.
+				task_to_process = thread_data->pool->_pop_from_work_queues(thread_data);
+				if (task_to_process) {
+					break;
+				}
+
 				if (!thread_data->pool->task_queue.first()) {
 					// There wasn't a task available yet.
 					// Let's wait for the next notification, then recheck.
@@ -246,7 +277,10 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && !p_pump_task) {
+			_push_to_work_queue(p_tasks[i]);
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -262,6 +296,59 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 	_notify_threads(caller_pool_thread, to_process, to_promote);
 }
 
+void WorkerThreadPool::_push_to_work_queue(Task *p_task) {
+	// Rotate across threads to spread the load. Idle threads will steal from the others anyway.
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &th = threads[work_queue_index];
+		work_queue_index = (work_queue_index + 1) % thread_count;
+		if (th.work_queue.try_push(p_task)) {
+			return;
+		}
+	}
+
+	// All the work queues are full. The shared queue has no limit.
+	task_queue.add_last(&p_task->task_elem);
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_from_work_queues(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->work_queue.try_pop(task)) {
+		return task;
+	}
+
+	// Nothing left in this thread's queue, so try to steal from others.
+	// Start at a random victim so thieves don't all contend on the same queue.
+	// The thread array may be growing meanwhile, so only look at the threads already published.
+	uint32_t thread_count = stealable_thread_count.load(std::memory_order_acquire);
+	ThreadData *thread_data = threads.ptr();
+	uint32_t seed = p_thread_data->steal_seed;
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	p_thread_data->steal_seed = seed;
+
+	uint32_t victim_index = seed % thread_count;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &victim = thread_data[victim_index];
+		victim_index = (victim_index + 1) % thread_count;
+		if (&victim != p_thread_data && victim.work_queue.try_pop(task)) {
+			return task;
+		}
+	}
+
+	return nullptr;
+}
+
+bool WorkerThreadPool::_are_work_queues_empty() const {
+	for (const ThreadData &th : threads) {
+		if (!th.work_queue.is_empty()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
 	uint32_t to_process = p_process_count;
 	uint32_t to_promote = p_promote_count;
@@ -286,9 +373,10 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 		if (th.signaled) {
 			continue;
 		}
-		if (th.current_task) {
+		const Task *th_task = th.current_task.load(std::memory_order_acquire);
+		if (th_task) {
 			// Good thread for promoting low-prio?
-			if (to_promote && th.awaited_task && th.current_task->low_priority) {
+			if (to_promote && th.awaited_task && th_task->low_priority) {
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
@@ -326,6 +414,90 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+void WorkerThreadPool::_free_group(Group *p_group) {
+	Task *task = p_group->tasks;
+	while (task) {
+		Task *next = task->next_group_task;
+		task_allocator.free(task);
+		task = next;
+	}
+	group_allocator.free(p_group);
+}
+
+bool WorkerThreadPool::_are_predecessors_valid(Span<TaskID> p_predecessors) const {
+	for (TaskID id : p_predecessors) {
+		// Tasks and groups share the ID counter. IDs no longer known have already completed.
+		if (id <= 0 || id >= (TaskID)last_task) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint32_t WorkerThreadPool::_link_to_predecessors(Span<TaskID> p_predecessors, Task *p_task, Group *p_group) {
+	uint32_t pending = 0;
+	for (TaskID id : p_predecessors) {
+		Task **taskp = tasks.getptr(id);
+		if (taskp) {
+			if (!(*taskp)->completed) {
+				if (p_task) {
+					(*taskp)->successor_tasks.push_back(p_task);
+				} else {
+					(*taskp)->successor_groups.push_back(p_group);
+				}
+				pending++;
+			}
+			continue;
+		}
+
+		Group **groupp = groups.getptr(id);
+		if (groupp && !(*groupp)->completed.is_set()) {
+			if (p_task) {
+				(*groupp)->successor_tasks.push_back(p_task);
+			} else {
+				(*groupp)->successor_groups.push_back(p_group);
+			}
+			pending++;
+		}
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_release_successors(LocalVector<Task *> &p_successor_tasks, LocalVector<Group *> &p_successor_groups, MutexLock<BinaryMutex> &p_lock) {
+	// Posting may temporarily unlock, so take ownership of the lists first.
+	LocalVector<Task *> successor_tasks = std::move(p_successor_tasks);
+	LocalVector<Group *> successor_groups = std::move(p_successor_groups);
+
+	for (Task *task : successor_tasks) {
+		task->pending_predecessors--;
+		if (task->pending_predecessors == 0) {
+			_post_tasks(&task, 1, !task->low_priority, p_lock, false);
+		}
+	}
+
+	LocalVector<Task *> tasks_posted;
+	for (Group *group : successor_groups) {
+		group->pending_predecessors--;
+		if (group->pending_predecessors > 0) {
+			continue;
+		}
+
+		if (group->tasks_used == 0) {
+			// No elements, so it's complete as soon as it's released.
+			group->completed.set_to(true);
+			_release_successors(group->successor_tasks, group->successor_groups, p_lock);
+			group->done_semaphore.post();
+			continue;
+		}
+
+		tasks_posted.clear();
+		for (Task *task = group->tasks; task; task = task->next_group_task) {
+			tasks_posted.push_back(task);
+		}
+		_post_tasks(tasks_posted.ptr(), tasks_posted.size(), !group->tasks->low_priority, p_lock, false);
+	}
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -342,9 +514,20 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_after(Span<TaskID> p_predecessors, void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, false, p_predecessors);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task, Span<TaskID> p_predecessors) {
 	MutexLock<BinaryMutex> lock(task_mutex);
 
+	if (unlikely(!_are_predecessors_valid(p_predecessors))) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_V_MSG(INVALID_TASK_ID, "Invalid predecessor Task or Group ID.");
+	}
+
 	// Get a free task
 	Task *task = task_allocator.alloc();
 	TaskID id = last_task++;
@@ -355,6 +538,8 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
 	task->is_pump_task = p_pump_task;
+	task->low_priority = !p_high_priority;
+	task->pending_predecessors = _link_to_predecessors(p_predecessors, task, nullptr);
 	tasks.insert(id, task);
 
 #ifdef THREADS_ENABLED
@@ -369,13 +554,17 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 			threads.resize_initialized(thread_count + 1);
 			threads[thread_count].index = thread_count;
 			threads[thread_count].pool = this;
+			threads[thread_count].steal_seed = thread_count + 1; // Must not be zero.
+			stealable_thread_count.store(thread_count + 1, std::memory_order_release);
 			threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
 			thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
 		}
 	}
 #endif
 
-	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+	if (task->pending_predecessors == 0) {
+		_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+	}
 
 	return id;
 }
@@ -388,6 +577,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task_bind(const Callable &p_actio
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_after(Span<TaskID> p_predecessors, const Callable &p_action, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false, p_predecessors);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task_after_bind(const Vector<TaskID> &p_predecessors, const Callable &p_action, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false, p_predecessors);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -417,7 +614,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task->self) {
+	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task.load(std::memory_order_relaxed)->self) {
 		// Deadlock prevention:
 		// When a pool thread wants to wait for an older task, the following situations can happen:
 		// 1. Awaited task is deep in the stack of the awaiter.
@@ -512,12 +709,14 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
+			const Task *caller_task = p_caller_pool_thread->current_task.load(std::memory_order_relaxed);
+
 			if (wait_is_over) {
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
-					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !_are_work_queues_empty()) ? 1 : 0;
+					uint32_t to_promote = caller_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
 						p_caller_pool_thread->signaled = true;
@@ -528,13 +727,15 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				break;
 			}
 
-			if (p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first()) {
+			if (caller_task->low_priority && low_priority_task_queue.first()) {
 				if (_try_promote_low_priority_task()) {
 					_notify_threads(p_caller_pool_thread, 1, 0);
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			task_to_process = _pop_from_work_queues(p_caller_pool_thread);
+
+			if (!task_to_process && task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -587,7 +788,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && _are_work_queues_empty()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -650,7 +851,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_predecessors) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -658,16 +859,27 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	MutexLock<BinaryMutex> lock(task_mutex);
 
+	if (unlikely(!_are_predecessors_valid(p_predecessors))) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_V_MSG(INVALID_TASK_ID, "Invalid predecessor Task or Group ID.");
+	}
+
 	Group *group = group_allocator.alloc();
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->pending_predecessors = _link_to_predecessors(p_predecessors, nullptr, group);
 
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
+		// With predecessors, it completes when they do.
+		if (group->pending_predecessors == 0) {
+			group->completed.set_to(true);
+			group->done_semaphore.post();
+		}
 		group->tasks_used = 0;
 		p_tasks = 0;
 		if (p_template_userdata) {
@@ -685,6 +897,9 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->low_priority = !p_high_priority;
+			task->next_group_task = group->tasks;
+			group->tasks = task;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -692,7 +907,9 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+	if (group->pending_predecessors == 0) {
+		_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+	}
 
 	return id;
 }
@@ -705,6 +922,18 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_after(Span<TaskID> p_predecessors, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_predecessors);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_after(Span<TaskID> p_predecessors, const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_predecessors);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task_after_bind(const Vector<TaskID> &p_predecessors, const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_predecessors);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -724,36 +953,35 @@ bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
 
 void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #ifdef THREADS_ENABLED
-	task_mutex.lock();
-	Group **groupp = groups.getptr(p_group);
-	task_mutex.unlock();
-	if (!groupp) {
-		ERR_FAIL_MSG("Invalid Group ID.");
-	}
-
+	Group *group = nullptr;
 	{
-		Group *group = *groupp;
-
-		if (this == singleton) {
-			_unlock_unlockable_mutexes();
-		}
-		group->done_semaphore.wait();
-		if (this == singleton) {
-			_lock_unlockable_mutexes();
+		MutexLock task_lock(task_mutex);
+		Group **groupp = groups.getptr(p_group);
+		if (!groupp) {
+			ERR_FAIL_MSG("Invalid Group ID.");
 		}
+		group = *groupp;
+	}
 
-		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
-		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
-
-		if (finished_users == max_users) {
-			// All tasks using this group are gone (finished before the group), so clear the group too.
-			MutexLock task_lock(task_mutex);
-			group_allocator.free(group);
-		}
+	if (this == singleton) {
+		_unlock_unlockable_mutexes();
+	}
+	group->done_semaphore.wait();
+	if (this == singleton) {
+		_lock_unlockable_mutexes();
 	}
 
+	// Forget the ID before the group can be freed, so it can't be looked up (e.g., as a predecessor) afterwards.
 	MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
 	groups.erase(p_group);
+
+	uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
+	uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
+
+	if (finished_users == max_users) {
+		// All tasks using this group are gone (finished before the group), so clear the group too.
+		_free_group(group);
+	}
 #endif
 }
 
@@ -764,8 +992,9 @@ int WorkerThreadPool::get_thread_index() const {
 
 WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() const {
 	int th_index = get_thread_index();
-	if (th_index != -1 && threads[th_index].current_task) {
-		return threads[th_index].current_task->self;
+	const Task *task = th_index != -1 ? threads[th_index].current_task.load(std::memory_order_relaxed) : nullptr;
+	if (task) {
+		return task->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
@@ -773,8 +1002,9 @@ WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() const {
 
 WorkerThreadPool::GroupID WorkerThreadPool::get_caller_group_id() const {
 	int th_index = get_thread_index();
-	if (th_index != -1 && threads[th_index].current_task && threads[th_index].current_task->group) {
-		return threads[th_index].current_task->group->self;
+	const Task *task = th_index != -1 ? threads[th_index].current_task.load(std::memory_order_relaxed) : nullptr;
+	if (task && task->group) {
+		return task->group->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
@@ -825,10 +1055,12 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	threads.reserve(5);
 #endif
 	threads.resize(p_thread_count);
+	stealable_thread_count.store(threads.size(), std::memory_order_release);
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		threads[i].index = i;
 		threads[i].pool = this;
+		threads[i].steal_seed = i + 1; // Must not be zero.
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
 		thread_ids.insert(threads[i].thread.get_id(), i);
 	}
@@ -873,6 +1105,7 @@ void WorkerThreadPool::finish() {
 	for (ThreadData &data : threads) {
 		data.thread.wait_to_finish();
 	}
+	stealable_thread_count.store(0, std::memory_order_relaxed);
 
 	{
 		MutexLock lock(task_mutex);
@@ -889,12 +1122,14 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 	ClassDB::bind_method(D_METHOD("get_caller_task_id"), &WorkerThreadPool::get_caller_task_id);
+	ClassDB::bind_method(D_METHOD("add_task_after", "predecessors", "action", "high_priority", "description"), &WorkerThreadPool::_add_task_after_bind, DEFVAL(false), DEFVAL(String()));
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
 	ClassDB::bind_method(D_METHOD("get_caller_group_id"), &WorkerThreadPool::get_caller_group_id);
+	ClassDB::bind_method(D_METHOD("add_group_task_after", "predecessors", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::_add_group_task_after_bind, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 }
 
 WorkerThreadPool *WorkerThreadPool::get_named_pool(const StringName &p_name) {
@@ -36,10 +36,12 @@
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/mpmc_queue.h"
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/span.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -69,6 +71,11 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		Task *tasks = nullptr; // Freed along with the group.
+		// Dependency graph. Guarded by the task mutex.
+		uint32_t pending_predecessors = 0;
+		LocalVector<Task *> successor_tasks;
+		LocalVector<Group *> successor_groups;
 	};
 
 	struct Task {
@@ -89,6 +96,11 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		Task *next_group_task = nullptr;
+		// Dependency graph. Guarded by the task mutex.
+		uint32_t pending_predecessors = 0;
+		LocalVector<Task *> successor_tasks;
+		LocalVector<Group *> successor_groups;
 
 		void free_template_userdata();
 		Task() :
@@ -100,6 +112,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t WORK_QUEUE_SIZE = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -119,10 +132,14 @@ private:
 		bool pre_exited_languages : 1;
 		bool exited_languages : 1;
 		bool has_pump_task : 1; // Threads can only have one pump task.
-		Task *current_task = nullptr;
+		std::atomic<Task *> current_task = nullptr; // Written without the lock for group tasks.
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		// High priority tasks are spread across these. They are pushed with the task mutex
+		// held, but popped without it, either by the owner or by other threads stealing work.
+		MPMCQueue<Task *, WORK_QUEUE_SIZE> work_queue;
+		uint32_t steal_seed = 0;
 
 		ThreadData() :
 				signaled(false),
@@ -133,6 +150,9 @@ private:
 	};
 
 	TightLocalVector<ThreadData> threads;
+	// Threads that can be stolen from. Thieves don't hold the lock, so they read this instead of the
+	// array size, which may change under them when a thread is added for a pump task.
+	std::atomic<uint32_t> stealable_thread_count = 0;
 	enum Runlevel {
 		RUNLEVEL_NORMAL,
 		RUNLEVEL_PRE_EXIT_LANGUAGES, // Block adding new tasks
@@ -168,6 +188,7 @@ private:
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	uint32_t work_queue_index = 0; // For rotating across work queues when posting.
 
 	uint64_t last_task = 1;
 	int pump_task_count = 0;
@@ -179,9 +200,17 @@ private:
 	void _process_task(Task *task);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task);
+	void _push_to_work_queue(Task *p_task);
+	Task *_pop_from_work_queues(ThreadData *p_thread_data);
+	bool _are_work_queues_empty() const;
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
+	void _free_group(Group *p_group);
+
+	bool _are_predecessors_valid(Span<TaskID> p_predecessors) const;
+	uint32_t _link_to_predecessors(Span<TaskID> p_predecessors, Task *p_task, Group *p_group);
+	void _release_successors(LocalVector<Task *> &p_successor_tasks, LocalVector<Group *> &p_successor_groups, MutexLock<BinaryMutex> &p_lock);
 
 	static WorkerThreadPool *singleton;
 
@@ -194,8 +223,8 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false, Span<TaskID> p_predecessors = Span<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_predecessors = Span<TaskID>());
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -232,6 +261,9 @@ private:
 protected:
 	static void _bind_methods();
 
+	TaskID _add_task_after_bind(const Vector<TaskID> &p_predecessors, const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
+	GroupID _add_group_task_after_bind(const Vector<TaskID> &p_predecessors, const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
 public:
 	template <typename C, typename M, typename U>
 	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
@@ -246,6 +278,20 @@ public:
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String(), bool p_pump_task = false);
 	TaskID add_task_bind(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// The *_after() variants defer the task until all of the predecessors, either task or group IDs, have completed.
+	// This allows chaining work without blocking any thread on a wait. Predecessors already completed are ignored.
+	template <typename C, typename M, typename U>
+	TaskID add_template_task_after(Span<TaskID> p_predecessors, C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, false, p_predecessors);
+	}
+	TaskID add_native_task_after(Span<TaskID> p_predecessors, void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_after(Span<TaskID> p_predecessors, const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -263,6 +309,17 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	template <typename C, typename M, typename U>
+	GroupID add_template_group_task_after(Span<TaskID> p_predecessors, C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_predecessors);
+	}
+	GroupID add_native_group_task_after(Span<TaskID> p_predecessors, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_after(Span<TaskID> p_predecessors, const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
@@ -31,8 +31,10 @@
 #include "command_queue_mt.h"
 
 CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	// Unpublished ring headers must read as zero.
+	ring = (uint8_t *)memalloc_zeroed(RING_SIZE);
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	memfree(ring);
 }
@@ -33,6 +33,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/condition_variable.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
 #include "core/templates/tuple.h"
@@ -105,15 +106,71 @@ class CommandQueueMT {
 
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
 
+	// Plain pushes go into a ring without taking the mutex. A producer reserves space by moving
+	// ring_tail forward, constructs the command there and publishes it by storing its size in the
+	// header in front of it. Sync calls, commands too large for the ring, and pushes that find it
+	// full go into command_mem under the mutex instead. They set RING_LOCKED in ring_tail, which
+	// sends every later push there too until the pump has flushed command_mem, so commands still
+	// run in the order they were pushed in.
+	static const uint64_t RING_SIZE = DEFAULT_COMMAND_MEM_SIZE_KB * 1024;
+	static const uint64_t RING_MAX_COMMAND_SIZE = RING_SIZE / 8;
+	static const uint64_t RING_LOCKED = uint64_t(1) << 63;
+	static const uint64_t RING_PADDING = uint64_t(1) << 62; // Header flag for the unused end of the ring when a command wraps around.
+
+	static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "The ring size must be a power of two.");
+	static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+	uint8_t *ring = nullptr;
+	std::atomic<uint64_t> ring_tail{ 0 }; // Reserved up to here, plus RING_LOCKED.
+	std::atomic<uint64_t> ring_head{ 0 }; // Flushed up to here. Only the pump moves it.
+
 	BinaryMutex mutex;
 	LocalVector<uint8_t> command_mem;
 	ConditionVariable sync_cond_var;
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id{ WorkerThreadPool::INVALID_TASK_ID };
+	// Set once the pump task has been woken up, until it starts flushing. Pushes in between don't wake it up again.
+	std::atomic<bool> pump_notified{ false };
 	uint64_t flush_read_ptr = 0;
-	std::atomic<bool> pending{ false };
+	bool flushing = false;
+
+	_FORCE_INLINE_ std::atomic<uint64_t> *_get_ring_header(uint64_t p_offset) {
+		return reinterpret_cast<std::atomic<uint64_t> *>(&ring[p_offset]);
+	}
+
+	template <typename T, typename... Args>
+	_FORCE_INLINE_ bool _try_push_to_ring(Args &&...p_args) {
+		// Header plus the command, rounded up so the next header stays aligned.
+		constexpr uint64_t alloc_size = sizeof(uint64_t) + ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
+		if constexpr (alloc_size > RING_MAX_COMMAND_SIZE) {
+			return false;
+		}
+
+		uint64_t tail = ring_tail.load(std::memory_order_relaxed);
+		uint64_t offset;
+		uint64_t padding;
+		do {
+			if (tail & RING_LOCKED) {
+				return false;
+			}
+			offset = tail & (RING_SIZE - 1);
+			// Commands are contiguous, so one that doesn't fit before the end starts over at the beginning.
+			padding = offset + alloc_size > RING_SIZE ? RING_SIZE - offset : 0;
+			if (tail + padding + alloc_size - ring_head.load(std::memory_order_acquire) > RING_SIZE) {
+				return false; // Full.
+			}
+		} while (!ring_tail.compare_exchange_weak(tail, tail + padding + alloc_size));
+
+		if (padding) {
+			_get_ring_header(offset)->store(padding | RING_PADDING, std::memory_order_release);
+			offset = 0;
+		}
+		new (&ring[offset + sizeof(uint64_t)]) T(std::forward<Args>(p_args)...);
+		_get_ring_header(offset)->store(alloc_size, std::memory_order_release);
+		return true;
+	}
 
 	template <typename T, typename... Args>
 	_FORCE_INLINE_ void create_command(Args &&...p_args) {
@@ -126,17 +183,22 @@ class CommandQueueMT {
 		*(uint64_t *)&command_mem[size] = alloc_size;
 		void *cmd = &command_mem[size + sizeof(uint64_t)];
 		new (cmd) T(std::forward<Args>(p_args)...);
-		pending.store(true);
 	}
 
 	template <typename T, bool NeedsSync, typename... Args>
 	_FORCE_INLINE_ void _push_internal(Args &&...args) {
+		if constexpr (!NeedsSync) {
+			if (_try_push_to_ring<T>(std::forward<Args>(args)...)) {
+				_notify_pump();
+				return;
+			}
+		}
+
 		MutexLock mlock(mutex);
+		// Pushes that come after this command must wait behind it, see RING_LOCKED.
+		ring_tail.fetch_or(RING_LOCKED);
 		create_command<T>(std::forward<Args>(args)...);
-
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);
-		}
+		_notify_pump();
 
 		if constexpr (NeedsSync) {
 			sync_tail++;
@@ -144,6 +206,24 @@ class CommandQueueMT {
 		}
 	}
 
+	_FORCE_INLINE_ void _notify_pump() {
+		// Waking up the pump goes through the WorkerThreadPool task mutex, so it's only done once per flush.
+		// A flush clears the flag before it reads ring_tail, and pushes move ring_tail before they read
+		// the flag, all sequentially consistent. So either the flush sees the command, or the push sees
+		// the cleared flag and wakes up the pump again.
+		if (!pump_notified.load() && !pump_notified.exchange(true)) {
+			const WorkerThreadPool::TaskID task_id = pump_task_id.load(std::memory_order_relaxed);
+			if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+				WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+			}
+		}
+	}
+
+	_FORCE_INLINE_ bool _is_pending() const {
+		// Also differs while RING_LOCKED is set, as command_mem isn't empty then.
+		return ring_tail.load(std::memory_order_acquire) != ring_head.load(std::memory_order_relaxed);
+	}
+
 	_FORCE_INLINE_ void _prevent_sync_wraparound() {
 		bool safe_to_reset = !sync_awaiters;
 		bool already_sync_to_latest = sync_head == sync_tail;
@@ -153,43 +233,88 @@ class CommandQueueMT {
 		}
 	}
 
+	// Runs the commands in the ring up to the last reserved one.
+	void _flush_ring(MutexLock<BinaryMutex> &p_lock) {
+		uint64_t head = ring_head.load(std::memory_order_relaxed);
+		while (head != (ring_tail.load() & ~RING_LOCKED)) {
+			const uint64_t offset = head & (RING_SIZE - 1);
+			std::atomic<uint64_t> *header = _get_ring_header(offset);
+			uint64_t size;
+			while ((size = header->load(std::memory_order_acquire)) == 0) {
+				// Reserved, but the producer is still constructing the command.
+#ifdef THREADS_ENABLED
+				Thread::yield();
+#endif
+			}
+
+			if (!(size & RING_PADDING)) {
+				CommandBase *cmd = reinterpret_cast<CommandBase *>(&ring[offset + sizeof(uint64_t)]);
+				uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(p_lock);
+				cmd->call();
+				WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+				cmd->~CommandBase();
+			}
+
+			// Headers of later commands can land anywhere in this space, so it must read as unpublished.
+			size &= ~RING_PADDING;
+			memset(&ring[offset], 0, size);
+			head += size;
+			ring_head.store(head, std::memory_order_release);
+		}
+	}
+
 	void _flush() {
-		if (unlikely(flush_read_ptr)) {
+		if (unlikely(flushing)) {
 			// Re-entrant call.
 			return;
 		}
 
 		MutexLock lock(mutex);
+		flushing = true;
 
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
-			cmd->call();
-			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
-
-			// Handle potential realloc due to the command and unlock allowance.
-			cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-
-			if (unlikely(cmd->sync)) {
-				sync_head++;
-				lock.~MutexLock(); // Give an opportunity to awaiters right away.
-				sync_cond_var.notify_all();
-				new (&lock) MutexLock(mutex);
-				// Handle potential realloc happened during unlock.
-				cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
+		// Commands pushed from now on need another flush, so they must wake up the pump again.
+		pump_notified.exchange(false);
+
+		while (true) {
+			_flush_ring(lock);
+
+			// Checked with the mutex locked, so a command that set RING_LOCKED is in command_mem already.
+			if (!(ring_tail.load(std::memory_order_acquire) & RING_LOCKED)) {
+				break;
 			}
 
-			cmd->~CommandBase();
+			while (flush_read_ptr < command_mem.size()) {
+				uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
+				flush_read_ptr += 8;
+				CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
+				uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
+				cmd->call();
+				WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
 
-			flush_read_ptr += size;
-		}
+				// Handle potential realloc due to the command and unlock allowance.
+				cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
 
-		command_mem.clear();
-		pending.store(false);
-		flush_read_ptr = 0;
+				if (unlikely(cmd->sync)) {
+					sync_head++;
+					lock.~MutexLock(); // Give an opportunity to awaiters right away.
+					sync_cond_var.notify_all();
+					new (&lock) MutexLock(mutex);
+					// Handle potential realloc happened during unlock.
+					cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
+				}
+
+				cmd->~CommandBase();
+
+				flush_read_ptr += size;
+			}
 
+			command_mem.clear();
+			flush_read_ptr = 0;
+			// Everything pushed before the ring was locked has run, so pushes can use it again.
+			ring_tail.fetch_and(~RING_LOCKED);
+		}
+
+		flushing = false;
 		_prevent_sync_wraparound();
 	}
 
@@ -228,7 +353,7 @@ public:
 	}
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(pending.load())) {
+		if (unlikely(_is_pending())) {
 			_flush();
 		}
 	}
@@ -242,14 +367,24 @@ public:
 	}
 
 	void wait_and_flush() {
-		ERR_FAIL_COND(pump_task_id == WorkerThreadPool::INVALID_TASK_ID);
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id);
+		ERR_FAIL_COND(pump_task_id.load() == WorkerThreadPool::INVALID_TASK_ID);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id.load());
 		_flush();
 	}
 
+	// For pumps that may skip a flush after waking up. Calling this once they're able to flush again
+	// makes sure commands pushed in the meantime are not left waiting for the next wake-up.
+	void notify_pump_if_pending() {
+		if (_is_pending()) {
+			pump_notified.store(false);
+			_notify_pump();
+		}
+	}
+
 	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
 		MutexLock lock(mutex);
-		pump_task_id = p_task_id;
+		pump_task_id.store(p_task_id);
+		pump_notified.store(false);
 	}
 
 	CommandQueueMT();
@@ -0,0 +1,206 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+thread_local FrameArena::ThreadReference FrameArena::thread_reference;
+SafeNumeric<uint32_t> FrameArena::current_frame;
+#ifdef DEBUG_ENABLED
+SafeNumeric<uint32_t> FrameArena::escaped_allocations;
+#endif
+
+FrameArena::ThreadReference::~ThreadReference() {
+	if (arena) {
+		arena->_unreference();
+	}
+}
+
+FrameArena &FrameArena::_get_thread_arena() {
+	if (unlikely(!thread_reference.arena)) {
+		thread_reference.arena = memnew(FrameArena);
+	}
+	return *thread_reference.arena;
+}
+
+void FrameArena::_unreference() {
+	if (references.decrement() == 0) {
+		memdelete(this);
+	}
+}
+
+void FrameArena::_rewind() {
+	Block *prev = nullptr;
+	Block *block = first_block;
+	while (block) {
+		Block *next = block->next;
+		if (block->size > BLOCK_SIZE - BLOCK_HEADER_SIZE) {
+			// Made for a single big allocation. Don't keep it around.
+			if (prev) {
+				prev->next = next;
+			} else {
+				first_block = next;
+			}
+			memfree(block);
+		} else {
+#ifdef DEV_ENABLED
+			// Help catching uses of memory that should no longer be referenced.
+			memset(_get_block_data(block), 0xCD, block->used);
+#endif
+			block->used = 0;
+			prev = block;
+		}
+		block = next;
+	}
+	current_block = first_block;
+	last_allocation = nullptr;
+}
+
+void *FrameArena::_alloc(size_t p_bytes) {
+	CRASH_COND_MSG(p_bytes > UINT32_MAX, "FrameArena allocations are limited to 4 GiB.");
+
+	const uint32_t now = current_frame.get();
+	if (references.get() == 1) {
+		// Nothing is in use anymore, so everything can be reused.
+		if (current_block && (current_block != first_block || current_block->used > 0)) {
+			_rewind();
+		}
+	}
+#ifdef DEBUG_ENABLED
+	else if (unlikely(now != frame)) {
+		ERR_PRINT_ONCE("FrameArena: Memory allocated in a previous frame is still in use. Transient allocations must be freed before the frame ends.");
+	}
+#endif
+	frame = now;
+
+	const size_t size = HEADER_SIZE + ((p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+
+	// Blocks after the current one are unused, kept from previous frames.
+	Block *block = current_block;
+	while (block && block->used + size > block->size) {
+		block = block->next;
+	}
+	if (!block) {
+		const size_t block_size = MAX(BLOCK_SIZE, BLOCK_HEADER_SIZE + size);
+		block = memnew_placement(memalloc(block_size), Block);
+		block->size = block_size - BLOCK_HEADER_SIZE;
+		if (current_block) {
+			block->next = current_block->next;
+			current_block->next = block;
+		} else {
+			first_block = block;
+		}
+	}
+	current_block = block;
+
+	uint8_t *mem = _get_block_data(block) + block->used;
+	block->used += size;
+
+	Header *header = (Header *)mem;
+	header->arena = this;
+	header->size = p_bytes;
+	header->frame = now;
+
+	references.increment();
+	last_allocation = mem + HEADER_SIZE;
+	return last_allocation;
+}
+
+bool FrameArena::_try_resize_in_place(uint8_t *p_ptr, size_t p_bytes) {
+	if (p_ptr != last_allocation || p_bytes > UINT32_MAX) {
+		return false;
+	}
+
+	Header *header = _get_header(p_ptr);
+	const size_t old_size = HEADER_SIZE + ((header->size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+	const size_t new_size = HEADER_SIZE + ((p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+	if (current_block->used - old_size + new_size > current_block->size) {
+		return false;
+	}
+
+	current_block->used = current_block->used - old_size + new_size;
+	header->size = p_bytes;
+	return true;
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	return _get_thread_arena()._alloc(p_bytes);
+}
+
+void *FrameArena::realloc(void *p_ptr, size_t p_bytes) {
+	FrameArena &arena = _get_thread_arena();
+	if (!p_ptr) {
+		return arena._alloc(p_bytes);
+	}
+
+	const Header *header = _get_header(p_ptr);
+	if (header->arena == &arena && arena._try_resize_in_place((uint8_t *)p_ptr, p_bytes)) {
+		return p_ptr;
+	}
+
+	void *mem = arena._alloc(p_bytes);
+	memcpy(mem, p_ptr, MIN((size_t)header->size, p_bytes));
+	free(p_ptr);
+	return mem;
+}
+
+void FrameArena::free(void *p_ptr) {
+	if (!p_ptr) {
+		return;
+	}
+
+	const Header *header = _get_header(p_ptr);
+	FrameArena *arena = header->arena;
+#ifdef DEBUG_ENABLED
+	if (unlikely(current_frame.get() != header->frame)) {
+		escaped_allocations.increment();
+		ERR_PRINT_ONCE("FrameArena: Memory freed after the end of the frame it was allocated in. Transient allocations must not outlive their frame.");
+	}
+#endif
+
+	if (arena == thread_reference.arena && arena->last_allocation == p_ptr) {
+		// Give the memory back right away, so the next allocation can reuse it.
+		arena->current_block->used -= HEADER_SIZE + ((header->size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+		arena->last_allocation = nullptr;
+	}
+	arena->_unreference();
+}
+
+void FrameArena::advance_frame() {
+	current_frame.increment();
+}
+
+FrameArena::~FrameArena() {
+	Block *block = first_block;
+	while (block) {
+		Block *next = block->next;
+		memfree(block);
+		block = next;
+	}
+}
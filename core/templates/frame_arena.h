@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Thread-local bump allocator for transient, per-frame allocations.
+// Allocating is just bumping a pointer, and freeing only decrements a counter.
+// Once all the allocations of a thread's arena are freed, it starts over from
+// the beginning, so memory is recycled without ever returning it to the heap.
+// Memory allocated from an arena must not outlive the frame it was allocated in
+// (i.e., it must be freed before `Main::iteration()` ends). Threads that work
+// asynchronously to the main loop must not keep arena memory across that point either.
+// Allocations may be freed from any thread, even after the allocating thread has exited.
+// In debug builds, every allocation freed after the end of its frame is reported.
+class FrameArena {
+public:
+	static constexpr size_t ALIGNMENT = 16;
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+private:
+	struct Block {
+		Block *next = nullptr;
+		size_t size = 0; // Usable bytes, after the block header.
+		size_t used = 0;
+	};
+
+	struct Header {
+		FrameArena *arena = nullptr;
+		uint32_t size = 0;
+		uint32_t frame = 0;
+	};
+
+	static constexpr size_t BLOCK_HEADER_SIZE = (sizeof(Block) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	static constexpr size_t HEADER_SIZE = (sizeof(Header) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	// Drops the thread's reference to its arena when the thread exits.
+	struct ThreadReference {
+		FrameArena *arena = nullptr;
+		~ThreadReference();
+	};
+
+	Block *first_block = nullptr;
+	Block *current_block = nullptr;
+	uint8_t *last_allocation = nullptr; // Can be grown or shrunk in place.
+	// One per live allocation, plus one held by the owning thread. The arena is deleted when the
+	// last one is dropped, so allocations still live when their thread exits can be freed later.
+	SafeNumeric<uint32_t> references{ 1 };
+	uint32_t frame = 0;
+
+	static thread_local ThreadReference thread_reference;
+	static SafeNumeric<uint32_t> current_frame;
+#ifdef DEBUG_ENABLED
+	static SafeNumeric<uint32_t> escaped_allocations;
+#endif
+
+	_FORCE_INLINE_ static uint8_t *_get_block_data(Block *p_block) { return (uint8_t *)p_block + BLOCK_HEADER_SIZE; }
+	_FORCE_INLINE_ static Header *_get_header(void *p_ptr) { return (Header *)((uint8_t *)p_ptr - HEADER_SIZE); }
+
+	static FrameArena &_get_thread_arena();
+
+	void _unreference();
+	void _rewind();
+	void *_alloc(size_t p_bytes);
+	bool _try_resize_in_place(uint8_t *p_ptr, size_t p_bytes);
+
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_bytes);
+	static void free(void *p_ptr);
+
+	// Called by the main loop once per frame.
+	static void advance_frame();
+	static uint32_t get_frame() { return current_frame.get(); }
+
+	// Number of allocations not freed yet, from the calling thread's arena.
+	static uint32_t get_thread_live_allocations() { return _get_thread_arena().references.get() - 1; }
+#ifdef DEBUG_ENABLED
+	// Number of allocations freed after the end of their frame, from any thread. Only the first one is printed.
+	static uint32_t get_escaped_allocations() { return escaped_allocations.get(); }
+#endif
+
+	FrameArena() {}
+	~FrameArena();
+};
+
+// Allocator policy for LocalVector.
+class FrameAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return FrameArena::alloc(p_memory); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return FrameArena::realloc(p_ptr, p_memory); }
+	_FORCE_INLINE_ static void free(void *p_ptr) { FrameArena::free(p_ptr); }
+};
+
+// Allocator policy for the elements of HashMap.
+template <typename T>
+class FrameTypedAllocator {
+	static_assert(alignof(T) <= FrameArena::ALIGNMENT, "Type is over-aligned for FrameArena.");
+
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArena::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		p_allocation->~T();
+		FrameArena::free(p_allocation);
+	}
+};
+
+// Containers for temporary data that only lives within a frame, as those used while culling or stepping physics.
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameAllocator>;
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameTypedAllocator<HashMapElement<TKey, TValue>>>;
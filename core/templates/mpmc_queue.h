@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  mpmc_queue.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Bounded, lock-free, multi-producer/multi-consumer FIFO queue.
+// Based on Dmitry Vyukov's bounded MPMC queue: every cell carries a sequence
+// number that tells producers and consumers whether it's their turn to use it,
+// so the only contended operations are the CAS on the enqueue/dequeue positions.
+// Pushing fails when the queue is full and popping fails when it's empty;
+// callers are expected to have a fallback for the former.
+
+template <typename T, uint32_t CAPACITY>
+class MPMCQueue {
+	static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "MPMCQueue capacity must be a power of two.");
+	static_assert(std::is_trivially_copyable_v<T>, "MPMCQueue only supports trivially copyable types.");
+
+	static constexpr uint32_t MASK = CAPACITY - 1;
+
+	struct Cell {
+		std::atomic<uint32_t> sequence;
+		T data;
+	};
+
+	Cell cells[CAPACITY];
+
+	// Padded to keep producers and consumers from false sharing.
+	// Alignment attributes aren't used because this may live in arrays allocated by Memory.
+	std::atomic<uint32_t> enqueue_pos = 0;
+	char padding_enqueue[Thread::CACHE_LINE_BYTES - sizeof(std::atomic<uint32_t>)];
+	std::atomic<uint32_t> dequeue_pos = 0;
+	char padding_dequeue[Thread::CACHE_LINE_BYTES - sizeof(std::atomic<uint32_t>)];
+
+public:
+	bool try_push(const T &p_value) {
+		Cell *cell = nullptr;
+		uint32_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		while (true) {
+			cell = &cells[pos & MASK];
+			uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+			int32_t diff = (int32_t)(seq - pos);
+			if (diff == 0) {
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // Full.
+			} else {
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->data = p_value;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool try_pop(T &r_value) {
+		Cell *cell = nullptr;
+		uint32_t pos = dequeue_pos.load(std::memory_order_relaxed);
+		while (true) {
+			cell = &cells[pos & MASK];
+			uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+			int32_t diff = (int32_t)(seq - (pos + 1));
+			if (diff == 0) {
+				if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				return false; // Empty.
+			} else {
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		r_value = cell->data;
+		cell->sequence.store(pos + MASK + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Only exact when no push or pop is in progress; otherwise, just a hint.
+	_FORCE_INLINE_ uint32_t size() const {
+		return enqueue_pos.load(std::memory_order_relaxed) - dequeue_pos.load(std::memory_order_relaxed);
+	}
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+	_FORCE_INLINE_ constexpr uint32_t get_capacity() const { return CAPACITY; }
+
+	MPMCQueue() {
+		for (uint32_t i = 0; i < CAPACITY; i++) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	MPMCQueue(const MPMCQueue &) = delete;
+	MPMCQueue &operator=(const MPMCQueue &) = delete;
+};
@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  small_vector.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/fixed_vector.h"
+#include "core/templates/vector.h"
+
+/**
+ * A Vector that keeps up to INLINE_CAPACITY elements inline, without any heap allocation.
+ * Once it grows past that, elements move to a regular (copy-on-write) Vector, which is then
+ * shared on copies and conversions, like any other Vector.
+ * Useful for the many tiny arrays that are built, passed around and thrown away in hot code.
+ *
+ * Note: Like FixedVector, it assumes elements are trivially relocatable.
+ */
+template <typename T, uint32_t INLINE_CAPACITY>
+class SmallVector {
+	FixedVector<T, INLINE_CAPACITY> _inline;
+	Vector<T> _heap; // Only one of both is used at a time. Inline unless this is non-empty.
+
+	void _spill(uint32_t p_capacity) {
+		_heap.reserve_exact(p_capacity);
+		for (T &element : _inline) {
+			_heap.push_back(std::move(element));
+		}
+		_inline.clear();
+	}
+
+public:
+	_FORCE_INLINE_ bool is_inline() const { return _heap.is_empty(); }
+
+	_FORCE_INLINE_ uint32_t size() const { return is_inline() ? _inline.size() : (uint32_t)_heap.size(); }
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+
+	_FORCE_INLINE_ const T *ptr() const { return is_inline() ? _inline.ptr() : _heap.ptr(); }
+	_FORCE_INLINE_ T *ptrw() { return is_inline() ? _inline.ptr() : _heap.ptrw(); }
+
+	_FORCE_INLINE_ operator Span<T>() const { return Span<T>(ptr(), size()); }
+	_FORCE_INLINE_ Span<T> span() const { return operator Span<T>(); }
+
+	_FORCE_INLINE_ const T &operator[](uint32_t p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, size());
+		return ptr()[p_index];
+	}
+	_FORCE_INLINE_ const T &get(uint32_t p_index) const { return operator[](p_index); }
+	void set(uint32_t p_index, const T &p_elem) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, size());
+		ptrw()[p_index] = p_elem;
+	}
+
+	void push_back(const T &p_elem) {
+		if (is_inline()) {
+			if (!_inline.is_full()) {
+				_inline.push_back(p_elem);
+				return;
+			}
+			// The element may be one of ours, which spilling moves away.
+			T elem = p_elem;
+			_spill(INLINE_CAPACITY * 2);
+			_heap.push_back(std::move(elem));
+			return;
+		}
+		_heap.push_back(p_elem);
+	}
+
+	Error resize(uint32_t p_size) {
+		if (is_inline()) {
+			if (p_size <= INLINE_CAPACITY) {
+				return _inline.resize_initialized(p_size);
+			}
+			_spill(p_size);
+		}
+		// Shrinking doesn't move the elements back inline, so copies keep sharing the data.
+		// Resizing to zero frees the heap storage, and the inline storage is used from then on.
+		return _heap.resize_initialized(p_size);
+	}
+
+	void clear() {
+		_inline.clear();
+		_heap.clear();
+	}
+
+	// Shares the data if on the heap already, so it's cheap when big.
+	operator Vector<T>() const {
+		if (!is_inline()) {
+			return _heap;
+		}
+		Vector<T> ret;
+		ret.resize(_inline.size());
+		T *w = ret.ptrw();
+		for (uint32_t i = 0; i < _inline.size(); i++) {
+			w[i] = _inline.ptr()[i];
+		}
+		return ret;
+	}
+
+	_FORCE_INLINE_ const T *begin() const { return ptr(); }
+	_FORCE_INLINE_ const T *end() const { return ptr() + size(); }
+
+	SmallVector() = default;
+	SmallVector(std::initializer_list<T> p_init) {
+		if (p_init.size() > INLINE_CAPACITY) {
+			_heap.reserve_exact(p_init.size());
+		}
+		for (const T &element : p_init) {
+			push_back(element);
+		}
+	}
+	SmallVector(const Vector<T> &p_from) {
+		if (p_from.size() > (int64_t)INLINE_CAPACITY) {
+			_heap = p_from;
+			return;
+		}
+		for (const T &element : p_from) {
+			_inline.push_back(element);
+		}
+	}
+};
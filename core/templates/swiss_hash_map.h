@@ -0,0 +1,764 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/string/print_string.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * An open-addressing hash map in the style of SwissTable, with the same API as AHashMap.
+ *
+ * Like AHashMap, elements are stored contiguously in insertion order, erasing an element
+ * moves the last one into its place, and elements can be accessed by index.
+ *
+ * Slots are probed in groups of 16. Each slot has a control byte holding 7 bits of the hash
+ * of its element, so a whole group is compared against a key at once (with SSE2 when
+ * available) and keys are only compared for matching control bytes. This keeps lookups fast
+ * at high load factors and with expensive key comparisons, such as for String keys.
+ *
+ * Use AHashMap for maps that stay very small, since this map always has at least 16 slots.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	static constexpr uint32_t GROUP_SIZE = 16;
+	// Must be a power of two, and at least GROUP_SIZE.
+	static constexpr uint32_t INITIAL_CAPACITY = 16;
+
+private:
+	static constexpr uint8_t CTRL_EMPTY = 0x80;
+	static constexpr uint8_t CTRL_DELETED = 0xFE;
+
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+	MapKeyValue *_elements = nullptr;
+	uint32_t *_hashes = nullptr; // Hash of each element, so rehashing doesn't call the hasher again.
+	uint8_t *_ctrl = nullptr; // Per slot: CTRL_EMPTY, CTRL_DELETED, or the low 7 bits of the hash.
+	uint32_t *_slots = nullptr; // Per slot: index of the element.
+
+	// Number of slots, a power of two.
+	uint32_t _capacity = INITIAL_CAPACITY;
+	uint32_t _size = 0;
+	uint32_t _deleted = 0;
+
+	struct Group {
+#ifdef SWISS_HASH_MAP_SSE2
+		__m128i ctrl;
+
+		_FORCE_INLINE_ explicit Group(const uint8_t *p_ctrl) :
+				ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl))) {}
+
+		_FORCE_INLINE_ uint32_t match(uint8_t p_ctrl) const {
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(char(p_ctrl))));
+		}
+
+		// Empty and deleted slots are the only ones with the high bit set.
+		_FORCE_INLINE_ uint32_t match_free() const {
+			return _mm_movemask_epi8(ctrl);
+		}
+#else
+		const uint8_t *ctrl;
+
+		_FORCE_INLINE_ explicit Group(const uint8_t *p_ctrl) :
+				ctrl(p_ctrl) {}
+
+		_FORCE_INLINE_ uint32_t match(uint8_t p_ctrl) const {
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= uint32_t(ctrl[i] == p_ctrl) << i;
+			}
+			return mask;
+		}
+
+		_FORCE_INLINE_ uint32_t match_free() const {
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= uint32_t(ctrl[i] >> 7) << i;
+			}
+			return mask;
+		}
+#endif
+		_FORCE_INLINE_ uint32_t match_empty() const {
+			return match(CTRL_EMPTY);
+		}
+	};
+
+	static _FORCE_INLINE_ uint32_t _lowest_bit(uint32_t p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(p_mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, p_mask);
+		return index;
+#else
+		uint32_t index = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint8_t _get_h2(uint32_t p_hash) { return p_hash & 0x7F; }
+	// Keeps the load factor at 7/8 at most.
+	static _FORCE_INLINE_ uint32_t _get_max_size(uint32_t p_capacity) { return p_capacity - p_capacity / 8; }
+
+	static uint32_t _get_capacity_for(uint32_t p_size) {
+		uint32_t capacity = MAX(uint32_t(GROUP_SIZE), next_power_of_2(p_size));
+		while (_get_max_size(capacity) < p_size) {
+			capacity *= 2;
+		}
+		return capacity;
+	}
+
+	uint32_t _hash(const TKey &p_key) const {
+		return Hasher::hash(p_key);
+	}
+
+	// Probes groups with triangular steps, which visits every group once when their count is a power of two.
+	bool _lookup_idx_with_hash(const TKey &p_key, uint32_t &r_element_idx, uint32_t &r_slot, uint32_t p_hash) const {
+		if (unlikely(_ctrl == nullptr)) {
+			return false; // Failed lookups, no elements.
+		}
+
+		const uint32_t group_mask = _capacity / GROUP_SIZE - 1;
+		const uint8_t h2 = _get_h2(p_hash);
+		uint32_t group = (p_hash >> 7) & group_mask;
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group * GROUP_SIZE;
+			const Group g(_ctrl + base);
+			for (uint32_t mask = g.match(h2); mask; mask &= mask - 1) {
+				const uint32_t slot = base + _lowest_bit(mask);
+				const uint32_t element_idx = _slots[slot];
+				if (_hashes[element_idx] == p_hash && Comparator::compare(_elements[element_idx].key, p_key)) {
+					r_element_idx = element_idx;
+					r_slot = slot;
+					return true;
+				}
+			}
+
+			if (g.match_empty() || step > group_mask) {
+				return false;
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	bool _lookup_idx(const TKey &p_key, uint32_t &r_element_idx, uint32_t &r_slot) const {
+		if (unlikely(_ctrl == nullptr)) {
+			return false; // Failed lookups, no elements.
+		}
+		return _lookup_idx_with_hash(p_key, r_element_idx, r_slot, _hash(p_key));
+	}
+
+	uint32_t _find_free_slot(uint32_t p_hash) const {
+		const uint32_t group_mask = _capacity / GROUP_SIZE - 1;
+		uint32_t group = (p_hash >> 7) & group_mask;
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group * GROUP_SIZE;
+			const uint32_t mask = Group(_ctrl + base).match_free();
+			if (mask) {
+				return base + _lowest_bit(mask);
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	uint32_t _find_element_slot(uint32_t p_hash, uint32_t p_element_idx) const {
+		const uint32_t group_mask = _capacity / GROUP_SIZE - 1;
+		const uint8_t h2 = _get_h2(p_hash);
+		uint32_t group = (p_hash >> 7) & group_mask;
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group * GROUP_SIZE;
+			for (uint32_t mask = Group(_ctrl + base).match(h2); mask; mask &= mask - 1) {
+				const uint32_t slot = base + _lowest_bit(mask);
+				if (_slots[slot] == p_element_idx) {
+					return slot;
+				}
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	void _set_slot(uint32_t p_slot, uint32_t p_hash, uint32_t p_element_idx) {
+		if (_ctrl[p_slot] == CTRL_DELETED) {
+			_deleted--;
+		}
+		_ctrl[p_slot] = _get_h2(p_hash);
+		_slots[p_slot] = p_element_idx;
+	}
+
+	void _clear_slot(uint32_t p_slot) {
+		// A lookup stops at the first group with an empty slot. If this group has none,
+		// keys may have probed past it, so the slot must stay non-empty.
+		if (Group(_ctrl + (p_slot & ~(GROUP_SIZE - 1))).match_empty()) {
+			_ctrl[p_slot] = CTRL_EMPTY;
+		} else {
+			_ctrl[p_slot] = CTRL_DELETED;
+			_deleted++;
+		}
+	}
+
+	void _allocate_slots(uint32_t p_capacity) {
+		_capacity = p_capacity;
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(sizeof(uint8_t) * _capacity));
+		_slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * _capacity));
+		memset(_ctrl, CTRL_EMPTY, _capacity);
+		_deleted = 0;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		Memory::free_static(_ctrl);
+		Memory::free_static(_slots);
+		_allocate_slots(p_new_capacity);
+
+		const uint32_t max_size = _get_max_size(_capacity);
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(_elements, sizeof(MapKeyValue) * max_size));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(_hashes, sizeof(uint32_t) * max_size));
+
+		for (uint32_t i = 0; i < _size; i++) {
+			_set_slot(_find_free_slot(_hashes[i]), _hashes[i], i);
+		}
+	}
+
+	int32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(_ctrl == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate_slots(_capacity);
+			const uint32_t max_size = _get_max_size(_capacity);
+			_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_size));
+			_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_size));
+		}
+
+		uint32_t slot = _find_free_slot(p_hash);
+		if (_ctrl[slot] == CTRL_EMPTY && _size + _deleted >= _get_max_size(_capacity)) {
+			// Out of empty slots. If most of the used ones are deleted, rehashing in place is enough.
+			_resize_and_rehash((_size + 1) * 2 <= _get_max_size(_capacity) ? _capacity : _capacity * 2);
+			slot = _find_free_slot(p_hash);
+		}
+
+		memnew_placement(&_elements[_size], MapKeyValue(p_key, p_value));
+		_hashes[_size] = p_hash;
+		_set_slot(slot, p_hash, _size);
+		_size++;
+		return _size - 1;
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		_capacity = p_other._capacity;
+		_size = p_other._size;
+		_deleted = p_other._deleted;
+
+		if (p_other._ctrl == nullptr) {
+			return;
+		}
+
+		const uint32_t max_size = _get_max_size(_capacity);
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(sizeof(uint8_t) * _capacity));
+		_slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * _capacity));
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_size));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_size));
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			void *destination = _elements;
+			const void *source = p_other._elements;
+			memcpy(destination, source, sizeof(MapKeyValue) * _size);
+		} else {
+			for (uint32_t i = 0; i < _size; i++) {
+				memnew_placement(&_elements[i], MapKeyValue(p_other._elements[i]));
+			}
+		}
+
+		memcpy(_hashes, p_other._hashes, sizeof(uint32_t) * _size);
+		memcpy(_ctrl, p_other._ctrl, sizeof(uint8_t) * _capacity);
+		memcpy(_slots, p_other._slots, sizeof(uint32_t) * _capacity);
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		if (_ctrl == nullptr || (_size == 0 && _deleted == 0)) {
+			return;
+		}
+
+		memset(_ctrl, CTRL_EMPTY, _capacity);
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < _size; i++) {
+				_elements[i].key.~TKey();
+				_elements[i].value.~TValue();
+			}
+		}
+
+		_size = 0;
+		_deleted = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+
+		if (exists) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+
+		if (exists) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		return _lookup_idx(p_key, element_idx, slot);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+
+		if (!exists) {
+			return false;
+		}
+
+		_clear_slot(slot);
+		_elements[element_idx].key.~TKey();
+		_elements[element_idx].value.~TValue();
+		_size--;
+
+		if (element_idx < _size) {
+			memcpy((void *)&_elements[element_idx], (const void *)&_elements[_size], sizeof(MapKeyValue));
+			_hashes[element_idx] = _hashes[_size];
+			_slots[_find_element_slot(_hashes[_size], _size)] = element_idx;
+		}
+
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		ERR_FAIL_COND_V(_lookup_idx(p_new_key, element_idx, slot), false);
+		ERR_FAIL_COND_V(!_lookup_idx(p_old_key, element_idx, slot), false);
+		MapKeyValue &element = _elements[element_idx];
+		const_cast<TKey &>(element.key) = p_new_key;
+
+		_clear_slot(slot);
+		const uint32_t hash = _hash(p_new_key);
+		_hashes[element_idx] = hash;
+
+		if (_size + _deleted > _get_max_size(_capacity)) {
+			// Rehashing places every element, including this one.
+			_resize_and_rehash(_capacity);
+		} else {
+			_set_slot(_find_free_slot(hash), hash, element_idx);
+		}
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		const uint32_t capacity = _get_capacity_for(p_new_capacity);
+		if (_ctrl == nullptr) {
+			_capacity = capacity;
+			return; // Unallocated yet.
+		}
+		if (capacity <= _capacity) {
+			if (p_new_capacity < size()) {
+				WARN_VERBOSE("reserve() called with a capacity smaller than the current size. This is likely a mistake.");
+			}
+			return;
+		}
+		_resize_and_rehash(capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pair++;
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(pair, begin, end);
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		if (unlikely(_size == 0)) {
+			return Iterator(nullptr, nullptr, nullptr);
+		}
+		return Iterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		if (unlikely(_size == 0)) {
+			return ConstIterator(nullptr, nullptr, nullptr);
+		}
+		return ConstIterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		CRASH_COND(!exists);
+		return _elements[element_idx].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		uint32_t hash = _hash(p_key);
+		bool exists = _lookup_idx_with_hash(p_key, element_idx, slot, hash);
+
+		if (exists) {
+			return _elements[element_idx].value;
+		} else {
+			element_idx = _insert_element(p_key, TValue(), hash);
+			return _elements[element_idx].value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		uint32_t hash = _hash(p_key);
+		bool exists = _lookup_idx_with_hash(p_key, element_idx, slot, hash);
+
+		if (!exists) {
+			element_idx = _insert_element(p_key, p_value, hash);
+		} else {
+			_elements[element_idx].value = p_value;
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		uint32_t hash = _hash(p_key);
+		uint32_t element_idx = _insert_element(p_key, p_value, hash);
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Array methods. */
+
+	// Unsafe. Changing keys and going outside the bounds of an array can lead to undefined behavior.
+	KeyValue<TKey, TValue> *get_elements_ptr() {
+		return _elements;
+	}
+
+	// Returns the element index. If not found, returns -1.
+	int get_index(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		if (!exists) {
+			return -1;
+		}
+		return element_idx;
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, _size);
+		return _elements[p_index];
+	}
+
+	bool erase_by_index(uint32_t p_index) {
+		if (p_index >= size()) {
+			return false;
+		}
+		return erase(_elements[p_index].key);
+	}
+
+	/* Constructors */
+
+	SwissHashMap(SwissHashMap &&p_other) {
+		_elements = p_other._elements;
+		_hashes = p_other._hashes;
+		_ctrl = p_other._ctrl;
+		_slots = p_other._slots;
+		_capacity = p_other._capacity;
+		_size = p_other._size;
+		_deleted = p_other._deleted;
+
+		p_other._elements = nullptr;
+		p_other._hashes = nullptr;
+		p_other._ctrl = nullptr;
+		p_other._slots = nullptr;
+		p_other._capacity = INITIAL_CAPACITY;
+		p_other._size = 0;
+		p_other._deleted = 0;
+	}
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	// Reserves space for p_initial_capacity elements.
+	SwissHashMap(uint32_t p_initial_capacity) :
+			_capacity(_get_capacity_for(p_initial_capacity)) {
+	}
+	SwissHashMap() {}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (_ctrl != nullptr) {
+			if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+				for (uint32_t i = 0; i < _size; i++) {
+					_elements[i].key.~TKey();
+					_elements[i].value.~TValue();
+				}
+			}
+			Memory::free_static(_elements);
+			Memory::free_static(_hashes);
+			Memory::free_static(_ctrl);
+			Memory::free_static(_slots);
+			_elements = nullptr;
+			_hashes = nullptr;
+			_ctrl = nullptr;
+			_slots = nullptr;
+		}
+		_capacity = INITIAL_CAPACITY;
+		_size = 0;
+		_deleted = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
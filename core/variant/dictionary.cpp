@@ -213,6 +213,18 @@ bool Dictionary::set(const Variant &p_key, const Variant &p_value) {
 	return true;
 }
 
+const Variant *Dictionary::getptr_unchecked(const Variant &p_key) const {
+	return _p->variant_map.getptr(p_key);
+}
+
+bool Dictionary::set_unchecked(const Variant &p_key, const Variant &p_value) {
+	if (unlikely(_p->read_only)) {
+		return false;
+	}
+	_p->variant_map[p_key] = p_value;
+	return true;
+}
+
 int Dictionary::size() const {
 	return _p->variant_map.size();
 }
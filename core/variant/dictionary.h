@@ -69,6 +69,9 @@ public:
 	Variant get(const Variant &p_key, const Variant &p_default) const;
 	Variant get_or_add(const Variant &p_key, const Variant &p_default);
 	bool set(const Variant &p_key, const Variant &p_value);
+	// Skip the key and value type checks, for callers that already know them to match (e.g. the GDScript VM).
+	const Variant *getptr_unchecked(const Variant &p_key) const;
+	bool set_unchecked(const Variant &p_key, const Variant &p_value);
 
 	int size() const;
 	bool is_empty() const;
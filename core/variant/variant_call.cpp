@@ -34,6 +34,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/packed_math.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/templates/a_hash_map.h"
@@ -1167,6 +1168,51 @@ struct _VariantCall {
 		return ret;
 	}
 
+	static PackedFloat32Array func_PackedFloat32Array_lerp(PackedFloat32Array *p_instance, const PackedFloat32Array &p_to, double p_weight) {
+		PackedFloat32Array ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_to.size(), ret, "Cannot interpolate between arrays of different sizes.");
+		ret.resize(p_instance->size());
+		PackedMath::lerp(p_instance->ptr(), p_to.ptr(), p_weight, ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	static double func_PackedFloat32Array_dot(PackedFloat32Array *p_instance, const PackedFloat32Array &p_with) {
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_with.size(), 0.0, "Cannot compute the dot product of arrays of different sizes.");
+		return PackedMath::dot(p_instance->ptr(), p_with.ptr(), p_instance->size());
+	}
+
+	// Like Array.min() and Array.max(), an empty array has no minimum or maximum, so they return null.
+	static Variant func_PackedFloat32Array_min(PackedFloat32Array *p_instance) {
+		float min = 0.0f;
+		float max = 0.0f;
+		if (!PackedMath::min_max(p_instance->ptr(), p_instance->size(), min, max)) {
+			return Variant();
+		}
+		return min;
+	}
+
+	static Variant func_PackedFloat32Array_max(PackedFloat32Array *p_instance) {
+		float min = 0.0f;
+		float max = 0.0f;
+		if (!PackedMath::min_max(p_instance->ptr(), p_instance->size(), min, max)) {
+			return Variant();
+		}
+		return max;
+	}
+
+	static AABB func_PackedVector3Array_get_aabb(PackedVector3Array *p_instance) {
+		return PackedMath::compute_aabb(p_instance->ptr(), p_instance->size());
+	}
+
+	static PackedColorArray func_PackedColorArray_lerp(PackedColorArray *p_instance, const PackedColorArray &p_to, double p_weight) {
+		static_assert(sizeof(Color) == 4 * sizeof(float));
+		PackedColorArray ret;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_to.size(), ret, "Cannot interpolate between arrays of different sizes.");
+		ret.resize(p_instance->size());
+		PackedMath::lerp(reinterpret_cast<const float *>(p_instance->ptr()), reinterpret_cast<const float *>(p_to.ptr()), p_weight, reinterpret_cast<float *>(ret.ptrw()), ret.size() * 4);
+		return ret;
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = &VariantInternalAccessor<Callable>::get(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2893,6 +2939,10 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
 	bind_method(PackedFloat32Array, erase, sarray("value"), varray());
+	bind_function(PackedFloat32Array, lerp, _VariantCall::func_PackedFloat32Array_lerp, sarray("to", "weight"), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloat32Array_dot, sarray("with"), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloat32Array_min, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloat32Array_max, sarray(), varray());
 
 	/* Float64 Array */
 
@@ -3001,6 +3051,7 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
 	bind_method(PackedVector3Array, erase, sarray("value"), varray());
+	bind_function(PackedVector3Array, get_aabb, _VariantCall::func_PackedVector3Array_get_aabb, sarray(), varray());
 
 	/* Color Array */
 
@@ -3028,6 +3079,7 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedColorArray, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedColorArray, count, sarray("value"), varray());
 	bind_method(PackedColorArray, erase, sarray("value"), varray());
+	bind_function(PackedColorArray, lerp, _VariantCall::func_PackedColorArray_lerp, sarray("to", "weight"), varray());
 
 	/* Vector4 Array */
 
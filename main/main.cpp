@@ -52,6 +52,7 @@
 #include "core/os/time.h"
 #include "core/register_core_types.h"
 #include "core/string/translation_server.h"
+#include "core/templates/frame_arena.h"
 #include "core/version.h"
 #include "drivers/register_driver_types.h"
 #include "main/app_icon.gen.h"
@@ -4816,6 +4817,7 @@ bool Main::iteration() {
 
 	frames++;
 	Engine::get_singleton()->_process_frames++;
+	FrameArena::advance_frame();
 
 	if (frame > 1000000) {
 		// Wait a few seconds before printing FPS, as FPS reporting just after the engine has started is inaccurate.
@@ -3,6 +3,18 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    from SCons.Variables import BoolVariable
+
+    return [
+        BoolVariable(
+            "gdscript_jit",
+            "Translate hot, fully typed GDScript functions to native code (Linux x86_64 only)",
+            False,
+        ),
+    ]
+
+
 def configure(env):
     pass
 
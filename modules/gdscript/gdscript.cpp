@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -450,6 +451,7 @@ void GDScript::set_source_code(const String &p_code) {
 		return;
 	}
 	source = p_code;
+	bytecode_cache.clear();
 #ifdef TOOLS_ENABLED
 	source_changed_cache = true;
 #endif
@@ -811,6 +813,33 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+	GDScriptFunction::invalidate_call_site_caches();
+
+	if (!bytecode_cache.is_empty()) {
+		Vector<uint8_t> cached_bytecode = bytecode_cache;
+		bytecode_cache.clear();
+		// Falls back to compiling from source if anything in the cache can't be resolved anymore.
+		if (!has_instances && GDScriptBytecodeCache::load(this, cached_bytecode) == OK) {
+			can_run = ScriptServer::is_scripting_enabled() || tool;
+			if (can_run) {
+				Error err = _static_init();
+				if (err) {
+					reloading = false;
+					return err;
+				}
+			}
+
+#ifdef TOOLS_ENABLED
+			if (p_keep_state) {
+				update_exports();
+			}
+#endif
+
+			reloading = false;
+			return OK;
+		}
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -828,6 +857,9 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
+	// Parse the scripts this one refers to on worker threads, before the analyzer asks for them one by one.
+	GDScriptCache::parse_dependencies(&parser);
+
 	GDScriptAnalyzer analyzer(&parser);
 	err = analyzer.analyze();
 
@@ -1127,6 +1159,7 @@ Error GDScript::load_source_code(const String &p_path) {
 	}
 
 	source = s;
+	bytecode_cache.clear();
 	path = p_path;
 	path_valid = true;
 #ifdef TOOLS_ENABLED
@@ -1139,6 +1172,7 @@ Error GDScript::load_source_code(const String &p_path) {
 
 void GDScript::set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens) {
 	binary_tokens = p_binary_tokens;
+	bytecode_cache.clear();
 }
 
 const Vector<uint8_t> &GDScript::get_binary_tokens_source() const {
@@ -2327,6 +2361,7 @@ void GDScriptLanguage::finish() {
 
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
+	GDScriptBytecodeCache::clear();
 
 	// Clear dependencies between scripts, to ensure cyclic references are broken
 	// (to avoid leaks at exit).
@@ -2401,6 +2436,65 @@ void GDScriptLanguage::profiling_stop() {
 #endif
 }
 
+#ifdef DEBUG_ENABLED
+void GDScriptLanguage::set_sampling_active(bool p_active) {
+	if (p_active) {
+		sample_session_start.set(sample_request.get());
+	}
+	// Pairs with the fence in `_check_sample_request()`, so the session start is seen along with the flag.
+	sampling_active.store(p_active, std::memory_order_release);
+}
+
+void GDScriptLanguage::_check_sample_request() {
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (sample_request.get() != _sample_seen) {
+		_record_sample();
+	}
+}
+
+void GDScriptLanguage::_record_sample() {
+	// Every request since the last sample is attributed to the current stack,
+	// which includes time spent in native calls made from it.
+	uint32_t request = sample_request.get();
+	uint32_t count = request - _sample_seen;
+	// Left over from a previous session this thread stayed in script code through.
+	count = MIN(count, request - sample_session_start.get());
+	_sample_seen = request;
+	if (count == 0) {
+		return;
+	}
+
+	LocalVector<const CallLevel *> levels;
+	for (const CallLevel *cl = _call_stack; cl; cl = cl->prev) {
+		levels.push_back(cl);
+	}
+
+	// Folded stack, as read by flame graph tools: outermost frame first, separated by semicolons.
+	String folded;
+	for (int64_t i = int64_t(levels.size()) - 1; i >= 0; i--) {
+		const CallLevel *cl = levels[i];
+		if (!folded.is_empty()) {
+			folded += ";";
+		}
+		if (cl->function) {
+			folded += cl->function->get_script()->get_script_path() + ":" + String(cl->function->get_name());
+		} else {
+			folded += "?";
+		}
+		folded += ":" + itos(*cl->line);
+	}
+
+	MutexLock lock(sample_mutex);
+	folded_samples[folded] += count;
+}
+
+void GDScriptLanguage::take_folded_samples(HashMap<String, uint64_t> &r_samples) {
+	MutexLock lock(sample_mutex);
+	r_samples.clear();
+	SWAP(r_samples, folded_samples);
+}
+#endif
+
 int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) {
 	int current = 0;
 #ifdef DEBUG_ENABLED
@@ -2918,6 +3012,10 @@ String GDScriptLanguage::get_global_class_name(const String &p_path, String *r_b
 
 thread_local GDScriptLanguage::CallLevel *GDScriptLanguage::_call_stack = nullptr;
 thread_local uint32_t GDScriptLanguage::_call_stack_size = 0;
+#ifdef DEBUG_ENABLED
+std::atomic<bool> GDScriptLanguage::sampling_active{ false };
+thread_local uint32_t GDScriptLanguage::_sample_seen = 0;
+#endif
 
 GDScriptLanguage::CallLevel *GDScriptLanguage::_get_stack_level(uint32_t p_level) {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_level, _call_stack_size, nullptr);
@@ -2955,6 +3053,8 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	bytecode_cache_enabled = GLOBAL_DEF_RST("gdscript/bytecode_cache/enabled", false);
+	optimize_bytecode = GLOBAL_DEF_RST("debug/settings/gdscript/optimize_bytecode", true);
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
@@ -84,6 +84,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -181,6 +182,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> bytecode_cache; // Payload from `GDScriptBytecodeCache`, consumed by the next `reload()`.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -448,6 +450,8 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	bool track_call_stack = false;
 	bool track_locals = false;
+	bool bytecode_cache_enabled = false;
+	bool optimize_bytecode = true;
 
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
@@ -468,6 +472,21 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profiling;
 	bool profile_native_calls;
 	uint64_t script_frame_time;
+
+	// Sampling profiler: `GDScriptSamplingProfiler` bumps the request counter from a timer thread,
+	// and each thread running script code records its own call stack once it notices the change.
+	// The counter is only looked at while `sampling_active` is set, so a stopped profiler costs a single relaxed load.
+	// Threads catch up with the counter whenever they enter script code with an empty call stack, and never count
+	// requests made before the current session started.
+	static std::atomic<bool> sampling_active;
+	SafeNumeric<uint32_t> sample_request;
+	SafeNumeric<uint32_t> sample_session_start;
+	static thread_local uint32_t _sample_seen;
+	Mutex sample_mutex;
+	HashMap<String, uint64_t> folded_samples;
+
+	void _check_sample_request();
+	void _record_sample();
 #endif
 
 	HashMap<String, ObjectID> orphan_subclasses;
@@ -505,6 +524,13 @@ public:
 			return;
 		}
 
+#ifdef DEBUG_ENABLED
+		if (_call_stack_size == 0) {
+			// Requests made while this thread ran no script code must not be counted.
+			_sample_seen = sample_request.get();
+		}
+#endif
+
 		call_level->prev = _call_stack;
 		_call_stack = call_level;
 		call_level->stack = p_stack;
@@ -576,8 +602,24 @@ public:
 
 	} strings;
 
+#ifdef DEBUG_ENABLED
+	_FORCE_INLINE_ static bool is_sampling_active() { return sampling_active.load(std::memory_order_relaxed); }
+	_FORCE_INLINE_ static void check_sample_request() {
+		if (unlikely(is_sampling_active())) {
+			singleton->_check_sample_request();
+		}
+	}
+	void set_sampling_active(bool p_active);
+	void request_sample() { sample_request.increment(); }
+	void take_folded_samples(HashMap<String, uint64_t> &r_samples);
+#endif
+
 	_FORCE_INLINE_ bool should_track_call_stack() const { return track_call_stack; }
 	_FORCE_INLINE_ bool should_track_locals() const { return track_locals; }
+	_FORCE_INLINE_ bool is_bytecode_cache_enabled() const { return bytecode_cache_enabled; }
+	void set_bytecode_cache_enabled(bool p_enabled) { bytecode_cache_enabled = p_enabled; }
+	_FORCE_INLINE_ bool should_optimize_bytecode() const { return optimize_bytecode; }
+	void set_optimize_bytecode(bool p_enabled) { optimize_bytecode = p_enabled; } // For tests, the project setting is only read on startup.
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
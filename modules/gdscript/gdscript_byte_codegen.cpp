@@ -45,6 +45,7 @@ uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool
 uint32_t GDScriptByteCodeGenerator::add_local(const StringName &p_name, const GDScriptDataType &p_type) {
 	int stack_pos = locals.size() + GDScriptFunction::FIXED_ADDRESSES_MAX;
 	locals.push_back(StackSlot(p_type.builtin_type, p_type.can_contain_object()));
+	initialized_locals.erase(stack_pos); // The slot may still hold a value of a previous local.
 	add_stack_identifier(p_name, stack_pos);
 	return stack_pos;
 }
@@ -397,6 +398,7 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	}
 	function->_stack_size = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals + temporaries.size();
 	function->_instruction_args_size = instr_args_max;
+	function->_init_call_site_caches(call_site_count);
 
 #ifdef DEBUG_ENABLED
 	function->operator_names = operator_names;
@@ -573,12 +575,66 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	append(Address());
 	append(p_target);
 	append(p_operator);
-	append(0); // Signature storage.
-	append(0); // Return type storage.
+	// Two cache entries, so sites that see two type pairs (e.g. int then float) stay on the fast path.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
-	for (int i = 0; i < _pointer_size; i++) {
-		append(0); // Space for function pointer.
+	for (int entry = 0; entry < 2; entry++) {
+		append(0); // Signature storage.
+		append(0); // Return type storage.
+		for (int i = 0; i < _pointer_size; i++) {
+			append(0); // Space for function pointer.
+		}
+	}
+}
+
+// Operators the VM evaluates inline on the values held by the slots, instead of calling the validated evaluator.
+static GDScriptFunction::Opcode _get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_MULTIPLY_INT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_EQUAL_INT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_LESS_INT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_GREATER_INT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_MULTIPLY_FLOAT;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_DIVIDE_FLOAT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_LESS_FLOAT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_GREATER_FLOAT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && p_right_type == Variant::VECTOR3) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_ADD_VECTOR3;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_SUBTRACT_VECTOR3;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && p_right_type == Variant::FLOAT && p_operator == Variant::OP_MULTIPLY) {
+		return GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT;
 	}
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
 }
 
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
@@ -613,11 +669,21 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+		// Temporaries are initialized with their type and adjusted above, so the destination already holds
+		// a value of the result type, which is all the typed opcodes need to skip the evaluator call.
+		GDScriptFunction::Opcode opcode = GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+		if (GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+			opcode = _get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		}
+
+		last_operator_pos = opcodes.size();
+		append_opcode(opcode);
 		append(p_left_operand);
 		append(p_right_operand);
 		append(p_target);
-		append(op_func);
+		append(op_func); // Also kept by typed opcodes, for the JIT and for fusing with jumps.
+		last_operator_end = opcodes.size();
+		last_operator_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -630,12 +696,84 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	append(p_right_operand);
 	append(p_target);
 	append(p_operator);
-	append(0); // Signature storage.
-	append(0); // Return type storage.
+	// Two cache entries, so sites that see two type pairs (e.g. int then float) stay on the fast path.
 	constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*(opcodes.ptr()));
-	for (int i = 0; i < _pointer_size; i++) {
-		append(0); // Space for function pointer.
+	for (int entry = 0; entry < 2; entry++) {
+		append(0); // Signature storage.
+		append(0); // Return type storage.
+		for (int i = 0; i < _pointer_size; i++) {
+			append(0); // Space for function pointer.
+		}
+	}
+}
+
+// Whether the last instruction is a validated operator writing to the temporary `p_result`, which is consumed
+// by the instruction about to be emitted, so the operator can be rewritten instead.
+bool GDScriptByteCodeGenerator::_can_rewrite_last_operator(const Address &p_result) const {
+	if (!GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		return false;
+	}
+	if (last_operator_end < 0 || last_operator_end != opcodes.size() || p_result.mode != Address::TEMPORARY) {
+		return false;
+	}
+	const Vector<int> &indices = temporaries[p_result.address].bytecode_indices;
+	return !indices.is_empty() && indices[indices.size() - 1] == last_operator_pos + 3;
+}
+
+// `temp = a op b; local = temp` becomes `local = a op b`. Validated operators write the result in place
+// without changing its type, so only do it for typed locals that already hold a value of the result type,
+// and only for plain value types, which can't alias their operands. Typed members always hold a value of
+// their type, since the implicit initializer constructs them before any other code runs, so `hp -= damage`
+// and `speed = speed * drag` become a single instruction too.
+bool GDScriptByteCodeGenerator::_fold_operator_into_assign(const Address &p_target, const Address &p_source) {
+	if (p_target.mode == Address::LOCAL_VARIABLE) {
+		if (!initialized_locals.has(p_target.address)) {
+			return false;
+		}
+	} else if (p_target.mode != Address::MEMBER) {
+		return false;
 	}
+	if (p_target.type.kind != GDScriptDataType::BUILTIN || p_target.type.builtin_type != last_operator_type) {
+		return false;
+	}
+	switch (last_operator_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::COLOR:
+		case Variant::QUATERNION:
+			break;
+		default:
+			return false;
+	}
+	if (!_can_rewrite_last_operator(p_source)) {
+		return false;
+	}
+
+	Vector<int> &indices = temporaries.write[p_source.address].bytecode_indices;
+	indices.remove_at(indices.size() - 1);
+	opcodes.write[last_operator_pos + 3] = address_of(p_target);
+	last_operator_end = -1;
+	return true;
+}
+
+// `temp = a op b; jump-if-not temp` becomes a single compare-and-branch instruction.
+bool GDScriptByteCodeGenerator::_fuse_operator_with_jump_if_not(const Address &p_condition, List<int> &r_jump_addrs) {
+	if (last_operator_type != Variant::BOOL || !_can_rewrite_last_operator(p_condition)) {
+		return false;
+	}
+
+	opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+	r_jump_addrs.push_back(opcodes.size());
+	append(0); // Jump destination, will be patched.
+	last_operator_end = -1;
+	return true;
 }
 
 void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
@@ -786,7 +924,58 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 	ternary_result.pop_back();
 }
 
+// Element (or key, or value) type of a typed container, if it's a builtin type other than `Object`.
+static Variant::Type _get_builtin_element_type(const GDScriptDataType &p_container_type, int p_index) {
+	if (!p_container_type.has_container_element_type(p_index)) {
+		return Variant::NIL;
+	}
+	const GDScriptDataType element_type = p_container_type.get_container_element_type(p_index);
+	if (element_type.kind != GDScriptDataType::BUILTIN || element_type.builtin_type == Variant::OBJECT) {
+		return Variant::NIL;
+	}
+	return element_type.builtin_type;
+}
+
+// Whether `p_container[p_index]` can skip the container type checks, because the element type is known
+// and, when storing, `p_source` is of exactly that type. Returns the opcode to use, or `OPCODE_END`.
+static GDScriptFunction::Opcode _get_typed_container_opcode(const GDScriptCodeGenerator::Address &p_container, const GDScriptCodeGenerator::Address &p_index, const GDScriptCodeGenerator::Address *p_source) {
+	if (!GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		return GDScriptFunction::OPCODE_END;
+	}
+	if (IS_BUILTIN_TYPE(p_container, Variant::ARRAY)) {
+		const Variant::Type element_type = _get_builtin_element_type(p_container.type, 0);
+		if (element_type == Variant::NIL || !IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+			return GDScriptFunction::OPCODE_END;
+		}
+		if (p_source == nullptr) {
+			return GDScriptFunction::OPCODE_GET_TYPED_ARRAY_INDEXED;
+		}
+		return IS_BUILTIN_TYPE((*p_source), element_type) ? GDScriptFunction::OPCODE_SET_TYPED_ARRAY_INDEXED : GDScriptFunction::OPCODE_END;
+	}
+	if (IS_BUILTIN_TYPE(p_container, Variant::DICTIONARY)) {
+		const Variant::Type key_type = _get_builtin_element_type(p_container.type, 0);
+		if (key_type == Variant::NIL || !IS_BUILTIN_TYPE(p_index, key_type)) {
+			return GDScriptFunction::OPCODE_END;
+		}
+		if (p_source == nullptr) {
+			return GDScriptFunction::OPCODE_GET_TYPED_DICTIONARY_KEYED;
+		}
+		const Variant::Type value_type = _get_builtin_element_type(p_container.type, 1);
+		return IS_BUILTIN_TYPE((*p_source), value_type) ? GDScriptFunction::OPCODE_SET_TYPED_DICTIONARY_KEYED : GDScriptFunction::OPCODE_END;
+	}
+	return GDScriptFunction::OPCODE_END;
+}
+
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
+	const GDScriptFunction::Opcode typed_opcode = _get_typed_container_opcode(p_target, p_index, &p_source);
+	if (typed_opcode != GDScriptFunction::OPCODE_END) {
+		append_opcode(typed_opcode);
+		append(p_target);
+		append(p_index);
+		append(p_source);
+		return;
+	}
+
 	if (HAS_BUILTIN_TYPE(p_target)) {
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
@@ -816,6 +1005,15 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 }
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
+	const GDScriptFunction::Opcode typed_opcode = _get_typed_container_opcode(p_source, p_index, nullptr);
+	if (typed_opcode != GDScriptFunction::OPCODE_END) {
+		append_opcode(typed_opcode);
+		append(p_source);
+		append(p_index);
+		append(p_target);
+		return;
+	}
+
 	if (HAS_BUILTIN_TYPE(p_source)) {
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
@@ -842,6 +1040,40 @@ void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address
 	append(p_target);
 }
 
+// Native setter or getter of the `p_property` engine property of `p_class`, if it can be called directly with a
+// validated call, taking `p_value` when setting or writing into it when getting. Returns `nullptr` otherwise.
+static MethodBind *_get_native_property_accessor(const StringName &p_class, const StringName &p_property, const GDScriptCodeGenerator::Address &p_value, bool p_setter) {
+	if (!GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		return nullptr;
+	}
+	bool is_property = false;
+	if (ClassDB::get_property_index(p_class, p_property, &is_property) != -1 || !is_property) {
+		// Indexed properties pass the index as an extra argument.
+		return nullptr;
+	}
+	const StringName accessor_name = p_setter ? ClassDB::get_property_setter(p_class, p_property) : ClassDB::get_property_getter(p_class, p_property);
+	if (accessor_name == StringName()) {
+		return nullptr;
+	}
+	MethodBind *accessor = ClassDB::get_method(p_class, accessor_name);
+	if (accessor == nullptr || accessor->is_vararg()) {
+		return nullptr;
+	}
+	if (accessor->get_argument_count() != (p_setter ? 1 : 0) || accessor->has_return() == p_setter) {
+		return nullptr;
+	}
+	if (!p_setter && p_value.mode != GDScriptCodeGenerator::Address::TEMPORARY) {
+		// Validated calls assume the return slot already holds the return type, which only temporaries guarantee.
+		return nullptr;
+	}
+	// Objects would also need their class checked, leave them to the generic path.
+	const Variant::Type value_type = accessor->get_argument_type(p_setter ? 0 : -1);
+	if (value_type == Variant::OBJECT || !IS_BUILTIN_TYPE(p_value, value_type)) {
+		return nullptr;
+	}
+	return accessor;
+}
+
 void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target) && Variant::get_member_validated_setter(p_target.type.builtin_type, p_name) &&
 			IS_BUILTIN_TYPE(p_source, Variant::get_member_type(p_target.type.builtin_type, p_name))) {
@@ -855,6 +1087,17 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 #endif
 		return;
 	}
+	if (p_target.type.kind == GDScriptDataType::NATIVE) {
+		MethodBind *setter = _get_native_property_accessor(p_target.type.native_type, p_name, p_source, true);
+		if (setter) {
+			append_opcode(GDScriptFunction::OPCODE_SET_NAMED_NATIVE);
+			append(p_target);
+			append(p_source);
+			append(setter);
+			append(p_name);
+			return;
+		}
+	}
 	append_opcode(GDScriptFunction::OPCODE_SET_NAMED);
 	append(p_target);
 	append(p_source);
@@ -873,6 +1116,17 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 #endif
 		return;
 	}
+	if (p_source.type.kind == GDScriptDataType::NATIVE) {
+		MethodBind *getter = _get_native_property_accessor(p_source.type.native_type, p_name, p_target, false);
+		if (getter) {
+			append_opcode(GDScriptFunction::OPCODE_GET_NAMED_NATIVE);
+			append(p_source);
+			append(p_target);
+			append(getter);
+			append(p_name);
+			return;
+		}
+	}
 	append_opcode(GDScriptFunction::OPCODE_GET_NAMED);
 	append(p_source);
 	append(p_target);
@@ -880,12 +1134,23 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
+	// `OPCODE_SET_MEMBER` already bypasses the script, so the native setter can be called directly.
+	MethodBind *setter = _get_native_property_accessor(function->_script->get_instance_base_type(), p_name, p_value, true);
+	if (setter) {
+		write_call_method_bind_validated(Address(), Address(Address::SELF), setter, { p_value });
+		return;
+	}
 	append_opcode(GDScriptFunction::OPCODE_SET_MEMBER);
 	append(p_value);
 	append(p_name);
 }
 
 void GDScriptByteCodeGenerator::write_get_member(const Address &p_target, const StringName &p_name) {
+	MethodBind *getter = _get_native_property_accessor(function->_script->get_instance_base_type(), p_name, p_target, false);
+	if (getter) {
+		write_call_method_bind_validated(p_target, Address(Address::SELF), getter, Vector<Address>());
+		return;
+	}
 	append_opcode(GDScriptFunction::OPCODE_GET_MEMBER);
 	append(p_target);
 	append(p_name);
@@ -966,6 +1231,10 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (_fold_operator_into_assign(p_target, p_source)) {
+		return;
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type(0)) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type(0);
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -997,6 +1266,10 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_target);
 		append(p_source);
 	}
+
+	if (p_target.mode == Address::LOCAL_VARIABLE) {
+		initialized_locals.insert(p_target.address);
+	}
 }
 
 void GDScriptByteCodeGenerator::write_assign_null(const Address &p_target) {
@@ -1090,6 +1363,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_site_count++);
 	ct.cleanup();
 }
 
@@ -1115,6 +1389,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_site_count++);
 	ct.cleanup();
 }
 
@@ -1349,6 +1624,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_site_count++);
 	ct.cleanup();
 }
 
@@ -1362,6 +1638,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_site_count++);
 	ct.cleanup();
 }
 
@@ -1375,6 +1652,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(call_site_count++);
 	ct.cleanup();
 }
 
@@ -1509,6 +1787,9 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
+	if (_fuse_operator_with_jump_if_not(p_condition, if_jmp_addrs)) {
+		return;
+	}
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
@@ -1780,10 +2061,14 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_operator_end = -1; // The loop jumps back here.
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
+	if (_fuse_operator_with_jump_if_not(p_condition, while_jmp_addrs)) {
+		return;
+	}
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
@@ -1989,6 +2274,7 @@ void GDScriptByteCodeGenerator::clear_address(const Address &p_address) {
 
 	if (p_address.mode == Address::LOCAL_VARIABLE) {
 		dirty_locals.erase(p_address.address);
+		initialized_locals.insert(p_address.address);
 	}
 }
 
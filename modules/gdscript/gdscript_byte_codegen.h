@@ -99,6 +99,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int call_site_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -162,6 +163,17 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Peephole state. The last validated or typed operator can still be rewritten while it is the last
+	// instruction emitted and nothing was made to jump right after it (see `patch_jump()`).
+	int last_operator_pos = -1;
+	int last_operator_end = -1;
+	Variant::Type last_operator_type = Variant::NIL;
+	HashSet<int> initialized_locals; // Typed locals that were assigned since their slot was handed out.
+
+	bool _can_rewrite_last_operator(const Address &p_result) const;
+	bool _fold_operator_into_assign(const Address &p_target, const Address &p_source);
+	bool _fuse_operator_with_jump_if_not(const Address &p_condition, List<int> &r_jump_addrs);
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -453,6 +465,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_operator_end = -1; // The current position is now a jump target.
 	}
 
 public:
@@ -0,0 +1,1640 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/extension/gdextension_manager.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/os/os.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+static const uint8_t BYTECODE_CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+static const int BYTECODE_CACHE_MAX_DEPTH = 256;
+
+enum ObjectRef {
+	OBJECT_REF_NULL,
+	OBJECT_REF_GDSCRIPT,
+	OBJECT_REF_NATIVE_CLASS,
+	OBJECT_REF_RESOURCE,
+};
+
+enum VariantRef {
+	VARIANT_REF_VALUE,
+	VARIANT_REF_OBJECT,
+	VARIANT_REF_ARRAY,
+	VARIANT_REF_DICTIONARY,
+};
+
+static Vector<uint8_t> _md5(const uint8_t *p_data, int p_size) {
+	Vector<uint8_t> hash;
+	hash.resize(16);
+	CryptoCore::md5(p_data, p_size, hash.ptrw());
+	return hash;
+}
+
+class GDScriptBytecodeCache::Writer {
+	LocalVector<uint8_t> data;
+	bool error = false;
+
+public:
+	const GDScript *root = nullptr;
+
+	bool has_error() const { return error; }
+	void fail() { error = true; }
+	const LocalVector<uint8_t> &get_data() const { return data; }
+
+	void put_bytes(const uint8_t *p_bytes, uint32_t p_size) {
+		uint32_t position = data.size();
+		data.resize(position + p_size);
+		memcpy(data.ptr() + position, p_bytes, p_size);
+	}
+	void put_u8(uint8_t p_value) { data.push_back(p_value); }
+	void put_u32(uint32_t p_value) {
+		uint8_t bytes[4];
+		encode_uint32(p_value, bytes);
+		put_bytes(bytes, 4);
+	}
+	void put_i32(int32_t p_value) { put_u32((uint32_t)p_value); }
+	void put_string(const String &p_value) {
+		CharString utf8 = p_value.utf8();
+		put_u32(utf8.length());
+		put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+	void put_string_name(const StringName &p_value) { put_string(p_value); }
+	void put_string_vector(const Vector<String> &p_value) {
+		put_u32(p_value.size());
+		for (const String &E : p_value) {
+			put_string(E);
+		}
+	}
+	void put_property_info(const PropertyInfo &p_info) {
+		put_u32(p_info.type);
+		put_string(p_info.name);
+		put_string_name(p_info.class_name);
+		put_u32(p_info.hint);
+		put_string(p_info.hint_string);
+		put_u32(p_info.usage);
+	}
+
+	Writer(const GDScript *p_root) :
+			root(p_root) {}
+};
+
+class GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	uint32_t size = 0;
+	uint32_t position = 0;
+	bool error = false;
+
+public:
+	GDScript *root = nullptr;
+
+	bool has_error() const { return error; }
+	void fail() { error = true; }
+
+	const uint8_t *get_bytes(uint32_t p_size) {
+		if (error || p_size > size - position) {
+			error = true;
+			return nullptr;
+		}
+		const uint8_t *bytes = data + position;
+		position += p_size;
+		return bytes;
+	}
+	uint8_t get_u8() {
+		const uint8_t *bytes = get_bytes(1);
+		return bytes ? *bytes : 0;
+	}
+	uint32_t get_u32() {
+		const uint8_t *bytes = get_bytes(4);
+		return bytes ? decode_uint32(bytes) : 0;
+	}
+	int32_t get_i32() { return (int32_t)get_u32(); }
+	// Every element takes at least one byte, so larger counts can only come from a corrupt file.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		if (count > size - position) {
+			error = true;
+			return 0;
+		}
+		return count;
+	}
+	String get_string() {
+		uint32_t length = get_count();
+		const uint8_t *bytes = get_bytes(length);
+		if (bytes == nullptr || length == 0) {
+			return String();
+		}
+		String value;
+		if (value.append_utf8((const char *)bytes, length) != OK) {
+			error = true;
+		}
+		return value;
+	}
+	void skip_string() { get_bytes(get_count()); }
+	StringName get_string_name() { return StringName(get_string()); }
+	Vector<String> get_string_vector() {
+		Vector<String> value;
+		uint32_t count = get_count();
+		for (uint32_t i = 0; i < count && !error; i++) {
+			value.push_back(get_string());
+		}
+		return value;
+	}
+	Variant::Type get_type() {
+		uint32_t type = get_u32();
+		if (type >= Variant::VARIANT_MAX) {
+			error = true;
+			return Variant::NIL;
+		}
+		return (Variant::Type)type;
+	}
+	PropertyInfo get_property_info() {
+		PropertyInfo info;
+		info.type = get_type();
+		info.name = get_string();
+		info.class_name = get_string_name();
+		info.hint = (PropertyHint)get_u32();
+		info.hint_string = get_string();
+		info.usage = get_u32();
+		return info;
+	}
+
+	Reader(const Vector<uint8_t> &p_data, GDScript *p_root) :
+			data(p_data.ptr()), size(p_data.size()), root(p_root) {}
+};
+
+// Compiled functions point straight into the Variant and utility function tables.
+// Those pointers are stored by what they were looked up with, which stays valid across runs.
+struct GDScriptBytecodeCache::FunctionTables {
+	struct OperatorKey {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type type_a = Variant::NIL;
+		Variant::Type type_b = Variant::NIL;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, OperatorKey> operators;
+	RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setters;
+	RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+};
+
+Mutex GDScriptBytecodeCache::mutex;
+Vector<uint8_t> GDScriptBytecodeCache::build_key;
+HashMap<String, GDScriptBytecodeCache::FileHash> GDScriptBytecodeCache::file_hashes;
+GDScriptBytecodeCache::FunctionTables *GDScriptBytecodeCache::function_tables = nullptr;
+
+bool GDScriptBytecodeCache::is_enabled() {
+#ifdef TOOLS_ENABLED
+	// Scripts change all the time while editing, so there is nothing to gain there.
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+#endif
+	return GDScriptLanguage::get_singleton()->is_bytecode_cache_enabled();
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	String cache_dir;
+	if (OS::get_singleton()->has_feature("template")) {
+		// Exported projects can't write to their own resources.
+		cache_dir = "user://gdscript_cache";
+	} else {
+		cache_dir = ProjectSettings::get_singleton()->get_project_data_path().path_join("gdscript_cache");
+	}
+	return cache_dir.path_join(p_script_path.get_file().get_basename() + "-" + p_script_path.md5_text() + ".gdbc");
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::_get_build_key() {
+	MutexLock lock(mutex);
+
+	if (!build_key.is_empty()) {
+		return build_key;
+	}
+
+	String key = vformat("%s.%s|%d|%d", GODOT_VERSION_FULL_BUILD, GODOT_VERSION_HASH, (int)sizeof(void *), (int)sizeof(real_t));
+#ifdef DEBUG_ENABLED
+	key += "|debug";
+#endif
+#ifdef TOOLS_ENABLED
+	key += "|tools";
+#endif
+	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
+		key += "|locals";
+	}
+	if (EngineDebugger::is_active()) {
+		key += "|debugger";
+	}
+	if (!GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		// The code generator merges fewer instructions, so the same source gives different bytecode.
+		key += "|unoptimized";
+	}
+
+	// Global classes, autoloads and extensions change what identifiers resolve to, without touching any script.
+	LocalVector<StringName> global_classes;
+	ScriptServer::get_global_class_list(global_classes);
+	global_classes.sort_custom<StringName::AlphCompare>();
+	for (const StringName &name : global_classes) {
+		key += "|" + name + "=" + ScriptServer::get_global_class_path(name);
+	}
+
+	LocalVector<String> autoloads;
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		autoloads.push_back(String(E.key) + "=" + E.value.path + (E.value.is_singleton ? "*" : ""));
+	}
+	autoloads.sort();
+	for (const String &autoload : autoloads) {
+		key += "|" + autoload;
+	}
+
+	if (GDExtensionManager::get_singleton()) {
+		Vector<String> extensions = GDExtensionManager::get_singleton()->get_loaded_extensions();
+		extensions.sort();
+		for (const String &extension : extensions) {
+			key += "|" + extension;
+		}
+	}
+
+	build_key = key.md5_buffer();
+	return build_key;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::_get_source_hash(const GDScript *p_script) {
+	if (!p_script->binary_tokens.is_empty()) {
+		return _md5(p_script->binary_tokens.ptr(), p_script->binary_tokens.size());
+	}
+	CharString utf8 = p_script->source.utf8();
+	return _md5((const uint8_t *)utf8.get_data(), utf8.length());
+}
+
+GDScriptBytecodeCache::FileHash GDScriptBytecodeCache::_get_file_hash(const String &p_path) {
+	MutexLock lock(mutex);
+
+	if (const FileHash *cached = file_hashes.getptr(p_path)) {
+		return *cached;
+	}
+
+	// Read the file the same way `GDScriptParserRef` does, so the hashes can be compared.
+	FileHash hash;
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (FileAccess::exists(remapped_path)) {
+		if (remapped_path.has_extension("gdc")) {
+			Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
+			hash.md5 = _md5(tokens.ptr(), tokens.size());
+			hash.parser_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		} else {
+			String source = GDScriptCache::get_source_code(remapped_path);
+			CharString utf8 = source.utf8();
+			hash.md5 = _md5((const uint8_t *)utf8.get_data(), utf8.length());
+			hash.parser_hash = source.hash();
+		}
+	}
+
+	file_hashes.insert(p_path, hash);
+	return hash;
+}
+
+bool GDScriptBytecodeCache::_collect_dependencies(const GDScriptParser *p_parser, const String &p_root_path, HashMap<String, Vector<uint8_t>> &r_dependencies) {
+	// Dependencies of dependencies matter too, since their interfaces can change what gets compiled here.
+	List<const GDScriptParser *> pending;
+	pending.push_back(p_parser);
+	HashSet<String> visited;
+	visited.insert(p_root_path);
+
+	while (!pending.is_empty()) {
+		const GDScriptParser *parser = pending.front()->get();
+		pending.pop_front();
+
+		for (const KeyValue<String, Ref<GDScriptParserRef>> &E : parser->get_depended_parsers()) {
+			if (visited.has(E.key)) {
+				continue;
+			}
+			visited.insert(E.key);
+
+			const Ref<GDScriptParserRef> &ref = E.value;
+			if (ref.is_null() || ref->get_status() == GDScriptParserRef::EMPTY) {
+				print_verbose(vformat(R"(GDScript: Not caching bytecode for "%s", dependency "%s" was already released.)", p_root_path, E.key));
+				return false;
+			}
+
+			FileHash hash = _get_file_hash(E.key);
+			if (hash.md5.is_empty() || hash.parser_hash != ref->get_source_hash()) {
+				print_verbose(vformat(R"(GDScript: Not caching bytecode for "%s", dependency "%s" changed on disk.)", p_root_path, E.key));
+				return false;
+			}
+
+			r_dependencies.insert(E.key, hash.md5);
+			pending.push_back(ref->get_parser());
+		}
+	}
+
+	return true;
+}
+
+GDScriptBytecodeCache::FunctionTables *GDScriptBytecodeCache::_get_function_tables() {
+	MutexLock lock(mutex);
+
+	if (function_tables) {
+		return function_tables;
+	}
+
+	function_tables = memnew(FunctionTables);
+	FunctionTables &tables = *function_tables;
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		Variant::Type type = (Variant::Type)i;
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, type, (Variant::Type)j);
+				if (evaluator && !tables.operators.has(evaluator)) {
+					tables.operators.insert(evaluator, { (Variant::Operator)op, type, (Variant::Type)j });
+				}
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+			if (setter && !tables.setters.has(setter)) {
+				tables.setters.insert(setter, Pair<Variant::Type, StringName>(type, member));
+			}
+			Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+			if (getter && !tables.getters.has(getter)) {
+				tables.getters.insert(getter, Pair<Variant::Type, StringName>(type, member));
+			}
+		}
+
+		Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+		if (keyed_setter && !tables.keyed_setters.has(keyed_setter)) {
+			tables.keyed_setters.insert(keyed_setter, type);
+		}
+		Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+		if (keyed_getter && !tables.keyed_getters.has(keyed_getter)) {
+			tables.keyed_getters.insert(keyed_getter, type);
+		}
+		Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+		if (indexed_setter && !tables.indexed_setters.has(indexed_setter)) {
+			tables.indexed_setters.insert(indexed_setter, type);
+		}
+		Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+		if (indexed_getter && !tables.indexed_getters.has(indexed_getter)) {
+			tables.indexed_getters.insert(indexed_getter, type);
+		}
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+			if (builtin_method && !tables.builtin_methods.has(builtin_method)) {
+				tables.builtin_methods.insert(builtin_method, Pair<Variant::Type, StringName>(type, method));
+			}
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+			if (constructor && !tables.constructors.has(constructor)) {
+				tables.constructors.insert(constructor, Pair<Variant::Type, int>(type, j));
+			}
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		Variant::ValidatedUtilityFunction function = Variant::get_validated_utility_function(utility);
+		if (function && !tables.utilities.has(function)) {
+			tables.utilities.insert(function, utility);
+		}
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		GDScriptUtilityFunctions::FunctionPtr function = GDScriptUtilityFunctions::get_function(utility);
+		if (function && !tables.gds_utilities.has(function)) {
+			tables.gds_utilities.insert(function, utility);
+		}
+	}
+
+	return function_tables;
+}
+
+void GDScriptBytecodeCache::_write_object(Writer &p_writer, const Object *p_object) {
+	if (p_object == nullptr) {
+		p_writer.put_u8(OBJECT_REF_NULL);
+		return;
+	}
+
+	if (const GDScript *script = Object::cast_to<GDScript>(p_object)) {
+		// Inner classes are stored as the path of their file, plus the chain of class names down from it.
+		Vector<StringName> class_names;
+		const GDScript *root = script;
+		while (root->_owner != nullptr) {
+			class_names.push_back(root->local_name);
+			root = root->_owner;
+		}
+		if (root->path.is_empty() || root->path.contains("::")) {
+			p_writer.fail(); // Built-in scripts can't be looked up on their own.
+			return;
+		}
+		p_writer.put_u8(OBJECT_REF_GDSCRIPT);
+		p_writer.put_string(root->path);
+		p_writer.put_u32(class_names.size());
+		for (int i = class_names.size() - 1; i >= 0; i--) {
+			p_writer.put_string_name(class_names[i]);
+		}
+		return;
+	}
+
+	if (const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(p_object)) {
+		p_writer.put_u8(OBJECT_REF_NATIVE_CLASS);
+		p_writer.put_string_name(native_class->get_name());
+		return;
+	}
+
+	if (const Resource *resource = Object::cast_to<Resource>(p_object)) {
+		if (!resource->is_built_in()) {
+			p_writer.put_u8(OBJECT_REF_RESOURCE);
+			p_writer.put_string(resource->get_path());
+			return;
+		}
+	}
+
+	// Anything else only exists for this run.
+	p_writer.fail();
+}
+
+Variant GDScriptBytecodeCache::_read_object(Reader &p_reader) {
+	switch (p_reader.get_u8()) {
+		case OBJECT_REF_NULL: {
+			return Variant();
+		}
+		case OBJECT_REF_GDSCRIPT: {
+			String path = p_reader.get_string();
+			if (p_reader.has_error()) {
+				return Variant();
+			}
+
+			Ref<GDScript> script;
+			if (path == p_reader.root->path) {
+				script = Ref<GDScript>(p_reader.root);
+			} else {
+				Error err = OK;
+				script = GDScriptCache::get_shallow_script(path, err, p_reader.root->path);
+				if (err != OK || script.is_null()) {
+					p_reader.fail();
+					return Variant();
+				}
+			}
+
+			uint32_t depth = p_reader.get_count();
+			for (uint32_t i = 0; i < depth && script.is_valid(); i++) {
+				HashMap<StringName, Ref<GDScript>>::Iterator E = script->subclasses.find(p_reader.get_string_name());
+				script = E ? E->value : Ref<GDScript>();
+			}
+			if (script.is_null()) {
+				p_reader.fail();
+			}
+			return script;
+		}
+		case OBJECT_REF_NATIVE_CLASS: {
+			StringName name = p_reader.get_string_name();
+			const HashMap<StringName, int> &globals = GDScriptLanguage::get_singleton()->get_global_map();
+			if (!globals.has(name)) {
+				p_reader.fail();
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[globals[name]];
+		}
+		case OBJECT_REF_RESOURCE: {
+			String path = p_reader.get_string();
+			if (p_reader.has_error()) {
+				return Variant();
+			}
+			Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				p_reader.fail();
+			}
+			return resource;
+		}
+		default: {
+			p_reader.fail();
+			return Variant();
+		}
+	}
+}
+
+void GDScriptBytecodeCache::_write_variant(Writer &p_writer, const Variant &p_value, int p_depth) {
+	if (p_depth > BYTECODE_CACHE_MAX_DEPTH) {
+		p_writer.fail();
+		return;
+	}
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			p_writer.put_u8(VARIANT_REF_OBJECT);
+			_write_object(p_writer, p_value.get_validated_object());
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			p_writer.put_u8(VARIANT_REF_ARRAY);
+			p_writer.put_u8(array.is_typed());
+			if (array.is_typed()) {
+				p_writer.put_u32(array.get_typed_builtin());
+				p_writer.put_string_name(array.get_typed_class_name());
+				_write_object(p_writer, array.get_typed_script().get_validated_object());
+			}
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				_write_variant(p_writer, array[i], p_depth + 1);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_value;
+			p_writer.put_u8(VARIANT_REF_DICTIONARY);
+			p_writer.put_u8(dictionary.is_typed());
+			if (dictionary.is_typed()) {
+				p_writer.put_u32(dictionary.get_typed_key_builtin());
+				p_writer.put_string_name(dictionary.get_typed_key_class_name());
+				_write_object(p_writer, dictionary.get_typed_key_script().get_validated_object());
+				p_writer.put_u32(dictionary.get_typed_value_builtin());
+				p_writer.put_string_name(dictionary.get_typed_value_class_name());
+				_write_object(p_writer, dictionary.get_typed_value_script().get_validated_object());
+			}
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_u32(dictionary.size());
+			for (const KeyValue<Variant, Variant> &E : dictionary) {
+				_write_variant(p_writer, E.key, p_depth + 1);
+				_write_variant(p_writer, E.value, p_depth + 1);
+			}
+		} break;
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID: {
+			p_writer.fail(); // Only meaningful for this run.
+		} break;
+		default: {
+			int length = 0;
+			Error err = encode_variant(p_value, nullptr, length, false);
+			if (err != OK) {
+				p_writer.fail();
+				return;
+			}
+			Vector<uint8_t> buffer;
+			buffer.resize(length);
+			encode_variant(p_value, buffer.ptrw(), length, false);
+			p_writer.put_u8(VARIANT_REF_VALUE);
+			p_writer.put_u32(length);
+			p_writer.put_bytes(buffer.ptr(), length);
+		} break;
+	}
+}
+
+Variant GDScriptBytecodeCache::_read_variant(Reader &p_reader, int p_depth) {
+	if (p_depth > BYTECODE_CACHE_MAX_DEPTH) {
+		p_reader.fail();
+		return Variant();
+	}
+
+	switch (p_reader.get_u8()) {
+		case VARIANT_REF_VALUE: {
+			uint32_t length = p_reader.get_count();
+			const uint8_t *bytes = p_reader.get_bytes(length);
+			if (bytes == nullptr) {
+				return Variant();
+			}
+			Variant value;
+			int used = 0;
+			if (decode_variant(value, bytes, length, &used, false) != OK || (uint32_t)used != length) {
+				p_reader.fail();
+			}
+			return value;
+		}
+		case VARIANT_REF_OBJECT: {
+			return _read_object(p_reader);
+		}
+		case VARIANT_REF_ARRAY: {
+			Array array;
+			if (p_reader.get_u8()) {
+				Variant::Type type = p_reader.get_type();
+				StringName class_name = p_reader.get_string_name();
+				Variant script = _read_object(p_reader);
+				if (p_reader.has_error()) {
+					return Variant();
+				}
+				array.set_typed(type, class_name, script);
+			}
+			bool read_only = p_reader.get_u8();
+			uint32_t size = p_reader.get_count();
+			for (uint32_t i = 0; i < size && !p_reader.has_error(); i++) {
+				array.push_back(_read_variant(p_reader, p_depth + 1));
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case VARIANT_REF_DICTIONARY: {
+			Dictionary dictionary;
+			if (p_reader.get_u8()) {
+				Variant::Type key_type = p_reader.get_type();
+				StringName key_class_name = p_reader.get_string_name();
+				Variant key_script = _read_object(p_reader);
+				Variant::Type value_type = p_reader.get_type();
+				StringName value_class_name = p_reader.get_string_name();
+				Variant value_script = _read_object(p_reader);
+				if (p_reader.has_error()) {
+					return Variant();
+				}
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			bool read_only = p_reader.get_u8();
+			uint32_t size = p_reader.get_count();
+			for (uint32_t i = 0; i < size && !p_reader.has_error(); i++) {
+				Variant key = _read_variant(p_reader, p_depth + 1);
+				dictionary[key] = _read_variant(p_reader, p_depth + 1);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		default: {
+			p_reader.fail();
+			return Variant();
+		}
+	}
+}
+
+void GDScriptBytecodeCache::_write_data_type(Writer &p_writer, const GDScriptDataType &p_type) {
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string_name(p_type.native_type);
+	_write_object(p_writer, p_type.script_type);
+	p_writer.put_u8(p_type.script_type_ref.is_valid());
+	p_writer.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		_write_data_type(p_writer, element_type);
+	}
+}
+
+GDScriptDataType GDScriptBytecodeCache::_read_data_type(Reader &p_reader, int p_depth) {
+	GDScriptDataType type;
+	if (p_depth > BYTECODE_CACHE_MAX_DEPTH) {
+		p_reader.fail();
+		return type;
+	}
+
+	uint8_t kind = p_reader.get_u8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		p_reader.fail();
+		return type;
+	}
+	type.kind = (GDScriptDataType::Kind)kind;
+	type.builtin_type = p_reader.get_type();
+	type.native_type = p_reader.get_string_name();
+	Variant script = _read_object(p_reader);
+	type.script_type = Object::cast_to<Script>(script.get_validated_object());
+	// Classes of the script being loaded don't hold a reference, to avoid cycles (see `GDScriptCompiler::_gdtype_from_datatype()`).
+	if (p_reader.get_u8()) {
+		type.script_type_ref = Ref<Script>(type.script_type);
+	}
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		type.container_element_types.push_back(_read_data_type(p_reader, p_depth + 1));
+	}
+	return type;
+}
+
+void GDScriptBytecodeCache::_write_member_info(Writer &p_writer, const GDScript::MemberInfo &p_info) {
+	p_writer.put_i32(p_info.index);
+	p_writer.put_string_name(p_info.setter);
+	p_writer.put_string_name(p_info.getter);
+	_write_data_type(p_writer, p_info.data_type);
+	p_writer.put_property_info(p_info.property_info);
+}
+
+GDScript::MemberInfo GDScriptBytecodeCache::_read_member_info(Reader &p_reader) {
+	GDScript::MemberInfo info;
+	info.index = p_reader.get_i32();
+	info.setter = p_reader.get_string_name();
+	info.getter = p_reader.get_string_name();
+	info.data_type = _read_data_type(p_reader);
+	info.property_info = p_reader.get_property_info();
+	return info;
+}
+
+void GDScriptBytecodeCache::_write_method_info(Writer &p_writer, const MethodInfo &p_info) {
+	p_writer.put_string(p_info.name);
+	p_writer.put_property_info(p_info.return_val);
+	p_writer.put_u32(p_info.flags);
+	p_writer.put_i32(p_info.id);
+	p_writer.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		p_writer.put_property_info(argument);
+	}
+	p_writer.put_u32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		_write_variant(p_writer, default_argument);
+	}
+	p_writer.put_i32(p_info.return_val_metadata);
+	p_writer.put_u32(p_info.arguments_metadata.size());
+	for (int metadata : p_info.arguments_metadata) {
+		p_writer.put_i32(metadata);
+	}
+}
+
+MethodInfo GDScriptBytecodeCache::_read_method_info(Reader &p_reader) {
+	MethodInfo info;
+	info.name = p_reader.get_string();
+	info.return_val = p_reader.get_property_info();
+	info.flags = p_reader.get_u32();
+	info.id = p_reader.get_i32();
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		info.arguments.push_back(p_reader.get_property_info());
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		info.default_arguments.push_back(_read_variant(p_reader));
+	}
+	info.return_val_metadata = p_reader.get_i32();
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		info.arguments_metadata.push_back(p_reader.get_i32());
+	}
+	return info;
+}
+
+void GDScriptBytecodeCache::_write_function(Writer &p_writer, const GDScriptFunction *p_function) {
+	FunctionTables *tables = _get_function_tables();
+
+	p_writer.put_string_name(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		_write_data_type(p_writer, argument_type);
+	}
+	_write_data_type(p_writer, p_function->return_type);
+	_write_method_info(p_writer, p_function->method_info);
+	_write_variant(p_writer, p_function->rpc_config);
+
+	p_writer.put_i32(p_function->_initial_line);
+	p_writer.put_i32(p_function->_argument_count);
+	p_writer.put_i32(p_function->_vararg_index);
+	p_writer.put_i32(p_function->_stack_size);
+	p_writer.put_i32(p_function->_instruction_args_size);
+	p_writer.put_i32(p_function->_call_site_count);
+
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_i32(E.key);
+		p_writer.put_u32(E.value);
+	}
+
+	p_writer.put_u32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &E : p_function->stack_debug) {
+		p_writer.put_i32(E.line);
+		p_writer.put_i32(E.pos);
+		p_writer.put_u8(E.added);
+		p_writer.put_string_name(E.identifier);
+	}
+
+	p_writer.put_u32(p_function->code.size());
+	for (int word : p_function->code) {
+		p_writer.put_i32(word);
+	}
+	p_writer.put_u32(p_function->default_arguments.size());
+	for (int address : p_function->default_arguments) {
+		p_writer.put_i32(address);
+	}
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		_write_variant(p_writer, constant);
+	}
+	p_writer.put_u32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string_name(global_name);
+	}
+
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		RBMap<Variant::ValidatedOperatorEvaluator, FunctionTables::OperatorKey>::Element *E = tables->operators.find(evaluator);
+		if (E == nullptr) {
+			p_writer.fail();
+			return;
+		}
+		p_writer.put_u32(E->value().op);
+		p_writer.put_u32(E->value().type_a);
+		p_writer.put_u32(E->value().type_b);
+	}
+
+#define WRITE_NAMED_TABLE(m_vector, m_table)            \
+	p_writer.put_u32(p_function->m_vector.size());      \
+	for (const auto &function : p_function->m_vector) { \
+		auto *E = tables->m_table.find(function);       \
+		if (E == nullptr) {                             \
+			p_writer.fail();                            \
+			return;                                     \
+		}                                               \
+		p_writer.put_u32(E->value().first);             \
+		p_writer.put_string_name(E->value().second);    \
+	}
+
+#define WRITE_TYPED_TABLE(m_vector, m_table)            \
+	p_writer.put_u32(p_function->m_vector.size());      \
+	for (const auto &function : p_function->m_vector) { \
+		auto *E = tables->m_table.find(function);       \
+		if (E == nullptr) {                             \
+			p_writer.fail();                            \
+			return;                                     \
+		}                                               \
+		p_writer.put_u32(E->value());                   \
+	}
+
+	WRITE_NAMED_TABLE(setters, setters);
+	WRITE_NAMED_TABLE(getters, getters);
+	WRITE_TYPED_TABLE(keyed_setters, keyed_setters);
+	WRITE_TYPED_TABLE(keyed_getters, keyed_getters);
+	WRITE_TYPED_TABLE(indexed_setters, indexed_setters);
+	WRITE_TYPED_TABLE(indexed_getters, indexed_getters);
+	WRITE_NAMED_TABLE(builtin_methods, builtin_methods);
+
+#undef WRITE_NAMED_TABLE
+#undef WRITE_TYPED_TABLE
+
+	p_writer.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>>::Element *E = tables->constructors.find(constructor);
+		if (E == nullptr) {
+			p_writer.fail();
+			return;
+		}
+		p_writer.put_u32(E->value().first);
+		p_writer.put_i32(E->value().second);
+	}
+
+	p_writer.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		RBMap<Variant::ValidatedUtilityFunction, StringName>::Element *E = tables->utilities.find(utility);
+		if (E == nullptr) {
+			p_writer.fail();
+			return;
+		}
+		p_writer.put_string_name(E->value());
+	}
+
+	p_writer.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName>::Element *E = tables->gds_utilities.find(utility);
+		if (E == nullptr) {
+			p_writer.fail();
+			return;
+		}
+		p_writer.put_string_name(E->value());
+	}
+
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string_name(method->get_instance_class());
+		p_writer.put_string_name(method->get_name());
+		p_writer.put_u32(method->get_hash());
+	}
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = p_function->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		if (info == nullptr) {
+			p_writer.fail();
+			return;
+		}
+		p_writer.put_i32(info->capture_count);
+		p_writer.put_u8(info->use_self);
+		_write_function(p_writer, lambda);
+	}
+
+#ifdef DEBUG_ENABLED
+	p_writer.put_string_name(p_function->profile.signature);
+	p_writer.put_string_vector(p_function->operator_names);
+	p_writer.put_string_vector(p_function->setter_names);
+	p_writer.put_string_vector(p_function->getter_names);
+	p_writer.put_string_vector(p_function->builtin_methods_names);
+	p_writer.put_string_vector(p_function->constructors_names);
+	p_writer.put_string_vector(p_function->utilities_names);
+	p_writer.put_string_vector(p_function->gds_utilities_names);
+#endif
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &p_reader, GDScript *p_script, int p_depth) {
+	if (p_depth > BYTECODE_CACHE_MAX_DEPTH) {
+		p_reader.fail();
+		return nullptr;
+	}
+
+	// Mirrors `GDScriptByteCodeGenerator::write_start()` and `write_end()`.
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+	function->name = p_reader.get_string_name();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	function->_static = p_reader.get_u8();
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		function->argument_types.push_back(_read_data_type(p_reader));
+	}
+	function->return_type = _read_data_type(p_reader);
+	function->method_info = _read_method_info(p_reader);
+	function->rpc_config = _read_variant(p_reader);
+
+	function->_initial_line = p_reader.get_i32();
+	function->_argument_count = p_reader.get_i32();
+	function->_vararg_index = p_reader.get_i32();
+	function->_stack_size = p_reader.get_i32();
+	function->_instruction_args_size = p_reader.get_i32();
+	int call_site_count = p_reader.get_i32();
+	if (call_site_count < 0) {
+		p_reader.fail();
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		int slot = p_reader.get_i32();
+		function->temporary_slots[slot] = p_reader.get_type();
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = p_reader.get_i32();
+		stack_debug.pos = p_reader.get_i32();
+		stack_debug.added = p_reader.get_u8();
+		stack_debug.identifier = p_reader.get_string_name();
+		function->stack_debug.push_back(stack_debug);
+	}
+
+	count = p_reader.get_count();
+	function->code.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		function->code.write[i] = p_reader.get_i32();
+	}
+	count = p_reader.get_count();
+	function->default_arguments.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		function->default_arguments.write[i] = p_reader.get_i32();
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		function->constants.push_back(_read_variant(p_reader));
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		function->global_names.push_back(p_reader.get_string_name());
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		uint32_t op = p_reader.get_u32();
+		Variant::Type type_a = p_reader.get_type();
+		Variant::Type type_b = p_reader.get_type();
+		Variant::ValidatedOperatorEvaluator evaluator = op < Variant::OP_MAX ? Variant::get_validated_operator_evaluator((Variant::Operator)op, type_a, type_b) : nullptr;
+		if (evaluator == nullptr) {
+			p_reader.fail();
+		}
+		function->operator_funcs.push_back(evaluator);
+	}
+
+#define READ_NAMED_TABLE(m_vector, m_getter)                        \
+	count = p_reader.get_count();                                   \
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) { \
+		Variant::Type type = p_reader.get_type();                   \
+		StringName name = p_reader.get_string_name();               \
+		auto function_ptr = Variant::m_getter(type, name);          \
+		if (function_ptr == nullptr) {                              \
+			p_reader.fail();                                        \
+		}                                                           \
+		function->m_vector.push_back(function_ptr);                 \
+	}
+
+#define READ_TYPED_TABLE(m_vector, m_getter)                        \
+	count = p_reader.get_count();                                   \
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) { \
+		auto function_ptr = Variant::m_getter(p_reader.get_type()); \
+		if (function_ptr == nullptr) {                              \
+			p_reader.fail();                                        \
+		}                                                           \
+		function->m_vector.push_back(function_ptr);                 \
+	}
+
+	READ_NAMED_TABLE(setters, get_member_validated_setter);
+	READ_NAMED_TABLE(getters, get_member_validated_getter);
+	READ_TYPED_TABLE(keyed_setters, get_member_validated_keyed_setter);
+	READ_TYPED_TABLE(keyed_getters, get_member_validated_keyed_getter);
+	READ_TYPED_TABLE(indexed_setters, get_member_validated_indexed_setter);
+	READ_TYPED_TABLE(indexed_getters, get_member_validated_indexed_getter);
+	READ_NAMED_TABLE(builtin_methods, get_validated_builtin_method);
+
+#undef READ_NAMED_TABLE
+#undef READ_TYPED_TABLE
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		Variant::Type type = p_reader.get_type();
+		int index = p_reader.get_i32();
+		Variant::ValidatedConstructor constructor = index >= 0 && index < Variant::get_constructor_count(type) ? Variant::get_validated_constructor(type, index) : nullptr;
+		if (constructor == nullptr) {
+			p_reader.fail();
+		}
+		function->constructors.push_back(constructor);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(p_reader.get_string_name());
+		if (utility == nullptr) {
+			p_reader.fail();
+		}
+		function->utilities.push_back(utility);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(p_reader.get_string_name());
+		if (utility == nullptr) {
+			p_reader.fail();
+		}
+		function->gds_utilities.push_back(utility);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		StringName class_name = p_reader.get_string_name();
+		StringName method_name = p_reader.get_string_name();
+		uint32_t hash = p_reader.get_u32();
+		MethodBind *method = ClassDB::get_method(class_name, method_name);
+		if (method == nullptr || method->get_hash() != hash) {
+			p_reader.fail();
+		}
+		function->methods.push_back(method);
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		GDScript::LambdaInfo info;
+		info.capture_count = p_reader.get_i32();
+		info.use_self = p_reader.get_u8();
+		GDScriptFunction *lambda = _read_function(p_reader, p_script, p_depth + 1);
+		if (lambda == nullptr) {
+			break;
+		}
+		p_script->lambda_info.insert(lambda, info);
+		function->lambdas.push_back(lambda);
+	}
+
+#ifdef DEBUG_ENABLED
+	function->profile.signature = p_reader.get_string_name();
+	function->operator_names = p_reader.get_string_vector();
+	function->setter_names = p_reader.get_string_vector();
+	function->getter_names = p_reader.get_string_vector();
+	function->builtin_methods_names = p_reader.get_string_vector();
+	function->constructors_names = p_reader.get_string_vector();
+	function->utilities_names = p_reader.get_string_vector();
+	function->gds_utilities_names = p_reader.get_string_vector();
+#endif
+
+	if (p_reader.has_error()) {
+		for (GDScriptFunction *lambda : function->lambdas) {
+			p_script->lambda_info.erase(lambda);
+		}
+		memdelete(function);
+		return nullptr;
+	}
+
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+	function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+
+#define SET_TABLE_PTR(m_vector, m_ptr, m_count)    \
+	function->m_count = function->m_vector.size(); \
+	function->m_ptr = function->m_vector.is_empty() ? nullptr : function->m_vector.ptr();
+
+	SET_TABLE_PTR(operator_funcs, _operator_funcs_ptr, _operator_funcs_count);
+	SET_TABLE_PTR(setters, _setters_ptr, _setters_count);
+	SET_TABLE_PTR(getters, _getters_ptr, _getters_count);
+	SET_TABLE_PTR(keyed_setters, _keyed_setters_ptr, _keyed_setters_count);
+	SET_TABLE_PTR(keyed_getters, _keyed_getters_ptr, _keyed_getters_count);
+	SET_TABLE_PTR(indexed_setters, _indexed_setters_ptr, _indexed_setters_count);
+	SET_TABLE_PTR(indexed_getters, _indexed_getters_ptr, _indexed_getters_count);
+	SET_TABLE_PTR(builtin_methods, _builtin_methods_ptr, _builtin_methods_count);
+	SET_TABLE_PTR(constructors, _constructors_ptr, _constructors_count);
+	SET_TABLE_PTR(utilities, _utilities_ptr, _utilities_count);
+	SET_TABLE_PTR(gds_utilities, _gds_utilities_ptr, _gds_utilities_count);
+
+#undef SET_TABLE_PTR
+
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+	function->_init_call_site_caches(call_site_count);
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_write_class_shape(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string_name(p_script->local_name);
+	p_writer.put_string_name(p_script->global_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string_name(E.key);
+		p_writer.put_string(E.value->fully_qualified_name);
+		_write_class_shape(p_writer, E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_read_class_shape(Reader &p_reader, GDScript *p_script, bool p_make) {
+	StringName local_name = p_reader.get_string_name();
+	StringName global_name = p_reader.get_string_name();
+	String simplified_icon_path = p_reader.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses;
+	if (p_make) {
+		p_script->local_name = local_name;
+		p_script->global_name = global_name;
+		p_script->simplified_icon_path = simplified_icon_path;
+		old_subclasses = p_script->subclasses;
+		p_script->subclasses.clear();
+	} else if (p_script->local_name != local_name || p_script->global_name != global_name) {
+		p_reader.fail();
+		return;
+	}
+
+	uint32_t count = p_reader.get_count();
+	if (!p_make && count != p_script->subclasses.size()) {
+		p_reader.fail();
+		return;
+	}
+
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		StringName name = p_reader.get_string_name();
+		String fully_qualified_name = p_reader.get_string();
+
+		Ref<GDScript> subclass;
+		if (p_make) {
+			if (old_subclasses.has(name)) {
+				subclass = old_subclasses[name];
+			} else {
+				subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+			}
+			if (subclass.is_null()) {
+				subclass.instantiate();
+			}
+			subclass->fully_qualified_name = fully_qualified_name;
+			subclass->_owner = p_script;
+			subclass->path = p_script->path;
+			p_script->subclasses.insert(name, subclass);
+		} else {
+			HashMap<StringName, Ref<GDScript>>::Iterator E = p_script->subclasses.find(name);
+			if (!E || E->value->fully_qualified_name != fully_qualified_name) {
+				p_reader.fail();
+				return;
+			}
+			subclass = E->value;
+		}
+
+		_read_class_shape(p_reader, subclass.ptr(), p_make);
+	}
+}
+
+bool GDScriptBytecodeCache::_is_class_pristine(const GDScript *p_script) {
+	if (!p_script->member_functions.is_empty() || p_script->implicit_initializer || p_script->implicit_ready || p_script->static_initializer) {
+		return false;
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (!_is_class_pristine(E.value.ptr())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::_write_class(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_u8(p_script->tool);
+	p_writer.put_u8(p_script->_is_abstract);
+	p_writer.put_string_name(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+	_write_object(p_writer, p_script->base.ptr());
+	_write_variant(p_writer, p_script->rpc_config);
+
+	p_writer.put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		p_writer.put_string_name(E.key);
+		_write_member_info(p_writer, E.value);
+	}
+	p_writer.put_u32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_writer.put_string_name(member);
+	}
+	p_writer.put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		p_writer.put_string_name(E.key);
+		_write_member_info(p_writer, E.value);
+	}
+	p_writer.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string_name(E.key);
+		_write_method_info(p_writer, E.value);
+	}
+	p_writer.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string_name(E.key);
+		_write_variant(p_writer, E.value);
+	}
+#ifdef TOOLS_ENABLED
+	p_writer.put_u32(p_script->member_default_values.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->member_default_values) {
+		p_writer.put_string_name(E.key);
+		_write_variant(p_writer, E.value);
+	}
+#endif
+
+	p_writer.put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		_write_function(p_writer, E.value);
+	}
+	const GDScriptFunction *special_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : special_functions) {
+		p_writer.put_u8(function != nullptr);
+		if (function) {
+			_write_function(p_writer, function);
+		}
+	}
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string_name(E.key);
+		_write_class(p_writer, E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_read_class(Reader &p_reader, GDScript *p_script) {
+	// Same cleanup as `GDScriptCompiler::_prepare_compilation()`, minus the functions, since the script is pristine.
+	p_script->clearing = true;
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->members.clear();
+
+	HashMap<StringName, Variant> constants = p_script->constants;
+	p_script->constants.clear();
+	constants.clear();
+
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->_signals.clear();
+	p_script->initializer = nullptr;
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+#ifdef TOOLS_ENABLED
+	p_script->member_default_values.clear();
+#endif
+
+	p_script->clearing = false;
+
+	p_script->tool = p_reader.get_u8();
+	p_script->_is_abstract = p_reader.get_u8();
+
+	StringName native_name = p_reader.get_string_name();
+	const HashMap<StringName, int> &globals = GDScriptLanguage::get_singleton()->get_global_map();
+	if (!globals.has(native_name)) {
+		p_reader.fail();
+		return;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[globals[native_name]];
+	if (p_script->native.is_null()) {
+		p_reader.fail();
+		return;
+	}
+	p_script->base = _read_object(p_reader);
+	p_script->rpc_config = _read_variant(p_reader);
+
+	uint32_t count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->member_indices.insert(name, _read_member_info(p_reader));
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		p_script->members.insert(p_reader.get_string_name());
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->static_variables_indices.insert(name, _read_member_info(p_reader));
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->_signals.insert(name, _read_method_info(p_reader));
+	}
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->constants.insert(name, _read_variant(p_reader));
+	}
+#ifdef TOOLS_ENABLED
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		StringName name = p_reader.get_string_name();
+		p_script->member_default_values.insert(name, _read_variant(p_reader));
+	}
+#endif
+	if (p_reader.has_error()) {
+		return;
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		GDScriptFunction *function = _read_function(p_reader, p_script);
+		if (function) {
+			p_script->member_functions.insert(function->name, function);
+		}
+	}
+	if (GDScriptFunction **initializer = p_script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init)) {
+		p_script->initializer = *initializer;
+	}
+	GDScriptFunction **special_functions[] = { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer };
+	for (GDScriptFunction **function : special_functions) {
+		if (p_reader.get_u8() && !p_reader.has_error()) {
+			*function = _read_function(p_reader, p_script);
+		}
+	}
+
+	count = p_reader.get_count();
+	for (uint32_t i = 0; i < count && !p_reader.has_error(); i++) {
+		HashMap<StringName, Ref<GDScript>>::Iterator E = p_script->subclasses.find(p_reader.get_string_name());
+		if (!E) {
+			p_reader.fail();
+			return;
+		}
+		_read_class(p_reader, E->value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_finish_class(GDScript *p_script) {
+	// Inner classes are done first, like in `GDScriptCompiler::_compile_class()`.
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_finish_class(E.value.ptr());
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+	p_script->_static_default_init();
+	p_script->valid = true;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::read(const GDScript *p_script) {
+	const String cache_path = get_cache_path(p_script->path);
+	if (!FileAccess::exists(cache_path)) {
+		return Vector<uint8_t>();
+	}
+
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(cache_path);
+	Reader reader(buffer, nullptr);
+	String reason;
+
+	const uint8_t *magic = reader.get_bytes(4);
+	if (magic == nullptr || memcmp(magic, BYTECODE_CACHE_MAGIC, 4) != 0 || reader.get_u32() != FORMAT_VERSION) {
+		reason = "unknown format";
+	} else if (const uint8_t *key = reader.get_bytes(16); key == nullptr || memcmp(key, _get_build_key().ptr(), 16) != 0) {
+		reason = "engine build or project configuration changed";
+	} else if (const uint8_t *source_hash = reader.get_bytes(16); source_hash == nullptr || memcmp(source_hash, _get_source_hash(p_script).ptr(), 16) != 0) {
+		reason = "source changed";
+	} else {
+		uint32_t dependency_count = reader.get_count();
+		for (uint32_t i = 0; i < dependency_count && reason.is_empty(); i++) {
+			String dependency = reader.get_string();
+			const uint8_t *dependency_hash = reader.get_bytes(16);
+			if (dependency_hash == nullptr) {
+				break;
+			}
+			FileHash hash = _get_file_hash(dependency);
+			if (hash.md5.is_empty() || memcmp(dependency_hash, hash.md5.ptr(), 16) != 0) {
+				reason = vformat(R"(dependency "%s" changed)", dependency);
+			}
+		}
+	}
+
+	Vector<uint8_t> payload;
+	if (reason.is_empty()) {
+		const uint8_t *payload_hash = reader.get_bytes(16);
+		uint32_t payload_size = reader.get_count();
+		const uint8_t *payload_data = reader.get_bytes(payload_size);
+		if (payload_hash == nullptr || payload_data == nullptr || memcmp(payload_hash, _md5(payload_data, payload_size).ptr(), 16) != 0) {
+			reason = "file is corrupt";
+		} else {
+			payload.resize(payload_size);
+			memcpy(payload.ptrw(), payload_data, payload_size);
+		}
+	}
+
+	if (!reason.is_empty()) {
+		print_verbose(vformat(R"(GDScript: Ignoring bytecode cache for "%s", %s.)", p_script->path, reason));
+	}
+	return payload;
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_payload) {
+	Reader reader(p_payload, p_script);
+	reader.get_u32(); // Flags.
+	uint32_t dependency_count = reader.get_count();
+	for (uint32_t i = 0; i < dependency_count && !reader.has_error(); i++) {
+		reader.skip_string();
+	}
+
+	p_script->fully_qualified_name = reader.get_string();
+	_read_class_shape(reader, p_script, true);
+	if (reader.has_error()) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	p_script->bytecode_cache = p_payload;
+	return OK;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const Vector<uint8_t> &p_payload) {
+	if (!_is_class_pristine(p_script)) {
+		return ERR_ALREADY_IN_USE;
+	}
+
+	Reader reader(p_payload, p_script);
+	uint32_t flags = reader.get_u32();
+
+	// Register the dependencies the parser would have found, so `GDScriptCache::finish_compiling()` loads them.
+	uint32_t dependency_count = reader.get_count();
+	for (uint32_t i = 0; i < dependency_count && !reader.has_error(); i++) {
+		String dependency = reader.get_string();
+		Error err = OK;
+		GDScriptCache::get_shallow_script(dependency, err, p_script->path);
+		if (err != OK) {
+			return err;
+		}
+	}
+
+	if (reader.get_string() != p_script->fully_qualified_name) {
+		return ERR_FILE_CORRUPT;
+	}
+	_read_class_shape(reader, p_script, false);
+	if (reader.has_error()) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	// On failure, the state loaded so far is reset when the script is compiled from source instead.
+	_read_class(reader, p_script);
+	if (reader.has_error()) {
+		print_verbose(vformat(R"(GDScript: Ignoring bytecode cache for "%s", it refers to something that no longer exists.)", p_script->path));
+		return ERR_FILE_CORRUPT;
+	}
+
+	_finish_class(p_script);
+
+	if (flags & FLAG_ADD_STATIC_SCRIPT) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+Error GDScriptBytecodeCache::save(const GDScript *p_script, const GDScriptParser *p_parser, bool p_add_static_script) {
+	const String &path = p_script->path;
+	if (path.is_empty() || path.contains("::")) {
+		return ERR_UNAVAILABLE; // Built-in scripts are saved along with their owner.
+	}
+	if (!p_script->instances.is_empty()) {
+		// Live instances could already be running the new code, which fills the operator caches with pointers only valid for this run.
+		return ERR_UNAVAILABLE;
+	}
+
+	HashMap<String, Vector<uint8_t>> dependencies;
+	if (!_collect_dependencies(p_parser, path, dependencies)) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Writer payload(p_script);
+	payload.put_u32(p_add_static_script ? FLAG_ADD_STATIC_SCRIPT : 0);
+	payload.put_u32(dependencies.size());
+	for (const KeyValue<String, Vector<uint8_t>> &E : dependencies) {
+		payload.put_string(E.key);
+	}
+	payload.put_string(p_script->fully_qualified_name);
+	_write_class_shape(payload, p_script);
+	_write_class(payload, p_script);
+	if (payload.has_error()) {
+		print_verbose(vformat(R"(GDScript: Not caching bytecode for "%s", it refers to data that can't be saved.)", path));
+		return ERR_UNAVAILABLE;
+	}
+
+	Writer file(p_script);
+	file.put_bytes(BYTECODE_CACHE_MAGIC, 4);
+	file.put_u32(FORMAT_VERSION);
+	file.put_bytes(_get_build_key().ptr(), 16);
+	file.put_bytes(_get_source_hash(p_script).ptr(), 16);
+	file.put_u32(dependencies.size());
+	for (const KeyValue<String, Vector<uint8_t>> &E : dependencies) {
+		file.put_string(E.key);
+		file.put_bytes(E.value.ptr(), 16);
+	}
+	const LocalVector<uint8_t> &payload_data = payload.get_data();
+	file.put_bytes(_md5(payload_data.ptr(), payload_data.size()).ptr(), 16);
+	file.put_u32(payload_data.size());
+	file.put_bytes(payload_data.ptr(), payload_data.size());
+
+	// Write to a temporary file first, so other processes never see a partial cache.
+	const String cache_path = get_cache_path(path);
+	const String temp_path = cache_path + ".tmp";
+	Error err = DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	if (err != OK) {
+		return err;
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+		if (f.is_null()) {
+			return err;
+		}
+		f->store_buffer(file.get_data().ptr(), file.get_data().size());
+	}
+	Ref<DirAccess> da = DirAccess::create_for_path(cache_path);
+	if (da->file_exists(cache_path)) {
+		da->remove(cache_path);
+	}
+	return da->rename(temp_path, cache_path);
+}
+
+void GDScriptBytecodeCache::clear() {
+	MutexLock lock(mutex);
+
+	build_key.clear();
+	file_hashes.clear();
+	if (function_tables) {
+		memdelete(function_tables);
+		function_tables = nullptr;
+	}
+}
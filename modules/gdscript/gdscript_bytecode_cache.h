@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/vector.h"
+
+class GDScriptParser;
+
+// Persists the compiled state of a script (bytecode, constants and type information)
+// so later runs can skip parsing, analysis and code generation.
+// A cache file is only used when the engine build, the script source and the sources of
+// every script it depends on are exactly the same as when it was written.
+class GDScriptBytecodeCache {
+	class Writer;
+	class Reader;
+	struct FunctionTables;
+
+	struct FileHash {
+		Vector<uint8_t> md5;
+		uint32_t parser_hash = 0; // Same as `GDScriptParserRef::get_source_hash()`.
+	};
+
+	enum Flags {
+		FLAG_ADD_STATIC_SCRIPT = 1 << 0,
+	};
+
+	static Mutex mutex;
+	static Vector<uint8_t> build_key;
+	static HashMap<String, FileHash> file_hashes;
+	static FunctionTables *function_tables;
+
+	static Vector<uint8_t> _get_build_key();
+	static Vector<uint8_t> _get_source_hash(const GDScript *p_script);
+	static FileHash _get_file_hash(const String &p_path);
+	static bool _collect_dependencies(const GDScriptParser *p_parser, const String &p_root_path, HashMap<String, Vector<uint8_t>> &r_dependencies);
+	static FunctionTables *_get_function_tables();
+
+	static void _write_variant(Writer &p_writer, const Variant &p_value, int p_depth = 0);
+	static void _write_object(Writer &p_writer, const Object *p_object);
+	static void _write_data_type(Writer &p_writer, const GDScriptDataType &p_type);
+	static void _write_member_info(Writer &p_writer, const GDScript::MemberInfo &p_info);
+	static void _write_method_info(Writer &p_writer, const MethodInfo &p_info);
+	static void _write_class_shape(Writer &p_writer, const GDScript *p_script);
+	static void _write_class(Writer &p_writer, const GDScript *p_script);
+	static void _write_function(Writer &p_writer, const GDScriptFunction *p_function);
+
+	static Variant _read_variant(Reader &p_reader, int p_depth = 0);
+	static Variant _read_object(Reader &p_reader);
+	static GDScriptDataType _read_data_type(Reader &p_reader, int p_depth = 0);
+	static GDScript::MemberInfo _read_member_info(Reader &p_reader);
+	static MethodInfo _read_method_info(Reader &p_reader);
+	static void _read_class_shape(Reader &p_reader, GDScript *p_script, bool p_make);
+	static bool _is_class_pristine(const GDScript *p_script);
+	static void _read_class(Reader &p_reader, GDScript *p_script);
+	static GDScriptFunction *_read_function(Reader &p_reader, GDScript *p_script, int p_depth = 0);
+	static void _finish_class(GDScript *p_script);
+
+public:
+	// Bump whenever the bytecode or the layout of compiled functions changes.
+	static constexpr uint32_t FORMAT_VERSION = 6;
+
+	static bool is_enabled();
+	static String get_cache_path(const String &p_script_path);
+
+	// Returns the cached payload for the script, or an empty buffer if there is no valid cache.
+	static Vector<uint8_t> read(const GDScript *p_script);
+	// Creates the inner class objects, like `GDScriptCompiler::make_scripts()` does,
+	// and keeps the payload so the next `GDScript::reload()` loads from it instead of compiling.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_payload);
+	// Fills the script and its inner classes, like `GDScriptCompiler::compile()` does.
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_payload);
+	static Error save(const GDScript *p_script, const GDScriptParser *p_parser, bool p_add_static_script);
+
+	static void clear();
+};
@@ -32,10 +32,12 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -64,27 +66,40 @@ GDScriptAnalyzer *GDScriptParserRef::get_analyzer() {
 	return analyzer;
 }
 
+void GDScriptParserRef::_parse() {
+	MutexLock lock(parse_mutex);
+	if (status != EMPTY) {
+		return;
+	}
+
+	// Calling parse will clear the parser, which can destruct another GDScriptParserRef which can clear the last reference to the script with this path, calling remove_script, which clears this GDScriptParserRef.
+	// It's ok if its the first thing done here.
+	get_parser()->clear();
+	status = PARSED;
+	String remapped_path = ResourceLoader::path_remap(path);
+	if (remapped_path.has_extension("gdc")) {
+		Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
+		source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		result = get_parser()->parse_binary(tokens, path);
+	} else {
+		String source = GDScriptCache::get_source_code(remapped_path);
+		source_hash = source.hash();
+		result = get_parser()->parse(source, path, false);
+	}
+}
+
 Error GDScriptParserRef::raise_status(Status p_new_status) {
 	ERR_FAIL_COND_V(clearing, ERR_BUG);
+	if (p_new_status > EMPTY) {
+		// Also waits for a worker thread that may be parsing this script already.
+		_parse();
+	}
 	ERR_FAIL_COND_V(parser == nullptr && status != EMPTY, ERR_BUG);
 
 	while (result == OK && p_new_status > status) {
 		switch (status) {
 			case EMPTY: {
-				// Calling parse will clear the parser, which can destruct another GDScriptParserRef which can clear the last reference to the script with this path, calling remove_script, which clears this GDScriptParserRef.
-				// It's ok if its the first thing done here.
-				get_parser()->clear();
-				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.has_extension("gdc")) {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
-				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
-				}
+				_parse();
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -113,6 +128,8 @@ void GDScriptParserRef::clear() {
 	}
 	clearing = true;
 
+	parse_mutex.lock();
+
 	GDScriptParser *lparser = parser;
 	GDScriptAnalyzer *lanalyzer = analyzer;
 
@@ -122,6 +139,8 @@ void GDScriptParserRef::clear() {
 	result = OK;
 	source_hash = 0;
 
+	parse_mutex.unlock();
+
 	clearing = false;
 
 	if (lanalyzer != nullptr) {
@@ -327,6 +346,15 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
+	if (GDScriptBytecodeCache::is_enabled()) {
+		Vector<uint8_t> bytecode = GDScriptBytecodeCache::read(script.ptr());
+		if (!bytecode.is_empty() && GDScriptBytecodeCache::make_scripts(script.ptr(), bytecode) == OK) {
+			// No need to parse, `GDScript::reload()` will load the rest from the cache.
+			singleton->shallow_gdscript_cache[p_path] = script;
+			return script;
+		}
+	}
+
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
@@ -434,13 +462,115 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 	return err;
 }
 
+void GDScriptCache::_parse_dependency(void *p_userdata, uint32_t p_index) {
+	GDScriptParserRef **parser_refs = (GDScriptParserRef **)p_userdata;
+	parser_refs[p_index]->_parse();
+}
+
+void GDScriptCache::_parse_dependency_task(void *p_userdata) {
+	static_cast<GDScriptParserRef *>(p_userdata)->_parse();
+}
+
+void GDScriptCache::parse_dependencies(GDScriptParser *p_parser) {
+	if (singleton == nullptr) {
+		return;
+	}
+
+	MutexLock lock(singleton->mutex);
+
+	if (singleton->cleared) {
+		return;
+	}
+
+	// Only parsing is done ahead of time. Analysis resolves dependencies in order
+	// and shares state between scripts, so it stays on the calling thread.
+	HashSet<String> visited;
+	visited.insert(p_parser->script_path);
+
+	LocalVector<GDScriptParser *> wave = { p_parser };
+	while (!wave.is_empty()) {
+		LocalVector<GDScriptParserRef *> to_parse;
+		for (GDScriptParser *parser : wave) {
+			LocalVector<String> paths;
+			for (const String &path : parser->get_referenced_script_paths()) {
+				paths.push_back(path);
+			}
+			for (const StringName &name : parser->get_referenced_identifiers()) {
+				if (ScriptServer::is_global_class(name) && ScriptServer::get_global_class_language(name) == "GDScript") {
+					paths.push_back(ScriptServer::get_global_class_path(name));
+				}
+			}
+
+			for (const String &path : paths) {
+				if (visited.has(path)) {
+					continue;
+				}
+				visited.insert(path);
+
+				// Already parsed or being analyzed, or compiled and cached.
+				if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path)) {
+					continue;
+				}
+				if (!FileAccess::exists(ResourceLoader::path_remap(path))) {
+					continue;
+				}
+
+				Ref<GDScriptParserRef> ref;
+				ref.instantiate();
+				ref->path = path;
+				singleton->parser_map[path] = ref.ptr();
+				p_parser->prefetched_parsers.push_back(ref);
+				to_parse.push_back(ref.ptr());
+			}
+		}
+
+		if (to_parse.is_empty()) {
+			break;
+		}
+
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		if (to_parse.size() == 1 || pool == nullptr) {
+			for (GDScriptParserRef *ref : to_parse) {
+				ref->_parse();
+			}
+		} else if (pool->get_thread_index() != -1) {
+			// Threaded resource loads run here. A pool thread waiting for a group blocks without helping,
+			// so it would deadlock a single thread pool. Waiting for each task runs queued tasks meanwhile.
+			LocalVector<WorkerThreadPool::TaskID> task_ids;
+			for (GDScriptParserRef *ref : to_parse) {
+				task_ids.push_back(pool->add_native_task(&_parse_dependency_task, ref, false, "Parse GDScript dependency"));
+			}
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+			for (WorkerThreadPool::TaskID task_id : task_ids) {
+				pool->wait_for_task_completion(task_id);
+			}
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		} else {
+			WorkerThreadPool::GroupID group_id = pool->add_native_group_task(&_parse_dependency, to_parse.ptr(), to_parse.size(), -1, false, "Parse GDScript dependencies");
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+			pool->wait_for_group_task_completion(group_id);
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		}
+
+		// The parsers may have been cleared while the lock was lifted.
+		wave.clear();
+		for (GDScriptParserRef *ref : to_parse) {
+			if (ref->status == GDScriptParserRef::PARSED && ref->result == OK && ref->parser != nullptr) {
+				wave.push_back(ref->parser);
+			}
+		}
+	}
+}
+
 void GDScriptCache::add_static_script(Ref<GDScript> p_script) {
 	ERR_FAIL_COND_MSG(p_script.is_null(), "Trying to cache empty script as static.");
 	ERR_FAIL_COND_MSG(!p_script->is_valid(), "Trying to cache non-compiled script as static.");
+	MutexLock lock(singleton->mutex);
 	singleton->static_gdscript_cache[p_script->get_fully_qualified_name()] = p_script;
 }
 
 void GDScriptCache::remove_static_script(const String &p_fqcn) {
+	MutexLock lock(singleton->mutex);
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
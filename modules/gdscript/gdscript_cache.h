@@ -61,6 +61,10 @@ private:
 	uint32_t source_hash = 0;
 	bool clearing = false;
 	bool abandoned = false;
+	// Held while parsing, which may happen on a worker thread (see `GDScriptCache::parse_dependencies()`).
+	Mutex parse_mutex;
+
+	void _parse();
 
 	friend class GDScriptCache;
 	friend class GDScript;
@@ -103,6 +107,9 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	static void _parse_dependency(void *p_userdata, uint32_t p_index);
+	static void _parse_dependency_task(void *p_userdata);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
@@ -115,6 +122,7 @@ public:
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
 	static Error finish_compiling(const String &p_owner);
+	static void parse_dependencies(GDScriptParser *p_parser);
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_byte_codegen.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_utility_functions.h"
 
@@ -3332,6 +3333,11 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 		GDScriptCache::add_static_script(p_script);
 	}
 
+	// Saved before any of the new code runs, so it doesn't capture any runtime state.
+	if (GDScriptBytecodeCache::is_enabled()) {
+		GDScriptBytecodeCache::save(main_script, parser, has_static_data && !root->annotated_static_unload);
+	}
+
 	err = GDScriptCache::finish_compiling(main_script->path);
 	if (err) {
 		_set_error(R"(Failed to compile depended scripts.)", nullptr);
@@ -126,7 +126,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " ";
 				text += DADDR(2);
 
-				incr += 7 + _pointer_size;
+				incr += 5 + 2 * (2 + _pointer_size);
 			} break;
 			case OPCODE_OPERATOR_VALIDATED: {
 				text += "validated operator ";
@@ -141,6 +141,48 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_ADD_INT:
+			case OPCODE_SUBTRACT_INT:
+			case OPCODE_MULTIPLY_INT:
+			case OPCODE_EQUAL_INT:
+			case OPCODE_LESS_INT:
+			case OPCODE_GREATER_INT:
+			case OPCODE_ADD_FLOAT:
+			case OPCODE_SUBTRACT_FLOAT:
+			case OPCODE_MULTIPLY_FLOAT:
+			case OPCODE_DIVIDE_FLOAT:
+			case OPCODE_LESS_FLOAT:
+			case OPCODE_GREATER_FLOAT:
+			case OPCODE_ADD_VECTOR3:
+			case OPCODE_SUBTRACT_VECTOR3:
+			case OPCODE_MULTIPLY_VECTOR3_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 5;
+			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += ", jump-if-not to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr += 6;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -300,6 +342,29 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_SET_TYPED_ARRAY_INDEXED:
+			case OPCODE_SET_TYPED_DICTIONARY_KEYED: {
+				text += _code_ptr[ip] == OPCODE_SET_TYPED_ARRAY_INDEXED ? "set typed array indexed " : "set typed dictionary keyed ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "] = ";
+				text += DADDR(3);
+
+				incr += 4;
+			} break;
+			case OPCODE_GET_TYPED_ARRAY_INDEXED:
+			case OPCODE_GET_TYPED_DICTIONARY_KEYED: {
+				text += _code_ptr[ip] == OPCODE_GET_TYPED_ARRAY_INDEXED ? "get typed array indexed " : "get typed dictionary keyed ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "]";
+
+				incr += 4;
+			} break;
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -342,6 +407,32 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 4;
 			} break;
+			case OPCODE_SET_NAMED_NATIVE: {
+				text += "set_named native ";
+				text += DADDR(1);
+				text += "[\"";
+				text += _global_names_ptr[_code_ptr[ip + 4]];
+				text += "\"] = ";
+				text += DADDR(2);
+				text += " (";
+				text += _methods_ptr[_code_ptr[ip + 3]]->get_name();
+				text += ")";
+
+				incr += 5;
+			} break;
+			case OPCODE_GET_NAMED_NATIVE: {
+				text += "get_named native ";
+				text += DADDR(2);
+				text += " = ";
+				text += DADDR(1);
+				text += "[\"";
+				text += _global_names_ptr[_code_ptr[ip + 4]];
+				text += "\"] (";
+				text += _methods_ptr[_code_ptr[ip + 3]]->get_name();
+				text += ")";
+
+				incr += 5;
+			} break;
 			case OPCODE_SET_MEMBER: {
 				text += "set_member ";
 				text += "[\"";
@@ -708,7 +799,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -31,6 +31,58 @@
 #include "gdscript_function.h"
 
 #include "gdscript.h"
+#include "gdscript_jit.h"
+
+SafeNumeric<uint32_t> GDScriptFunction::call_site_cache_epoch{ 1 };
+BinaryMutex GDScriptFunction::call_site_cache_mutex;
+
+struct GDScriptCoroutineFramePool {
+	LocalVector<uint8_t *> free_frames[GDScriptFunction::COROUTINE_FRAME_SIZE_CLASSES];
+
+	~GDScriptCoroutineFramePool() {
+		for (LocalVector<uint8_t *> &frames : free_frames) {
+			for (uint8_t *frame : frames) {
+				Memory::free_static(frame);
+			}
+		}
+	}
+};
+
+static thread_local GDScriptCoroutineFramePool coroutine_frame_pool;
+
+uint8_t *GDScriptFunction::_alloc_coroutine_frame(uint32_t p_size, uint32_t &r_capacity) {
+	uint32_t size_class = 0;
+	while (size_class < COROUTINE_FRAME_SIZE_CLASSES && p_size > (1u << (COROUTINE_FRAME_MIN_SHIFT + size_class))) {
+		size_class++;
+	}
+	if (size_class == COROUTINE_FRAME_SIZE_CLASSES) {
+		r_capacity = p_size;
+		return (uint8_t *)Memory::alloc_static(p_size);
+	}
+
+	r_capacity = 1u << (COROUTINE_FRAME_MIN_SHIFT + size_class);
+	LocalVector<uint8_t *> &frames = coroutine_frame_pool.free_frames[size_class];
+	if (frames.is_empty()) {
+		return (uint8_t *)Memory::alloc_static(r_capacity);
+	}
+	uint8_t *frame = frames[frames.size() - 1];
+	frames.remove_at(frames.size() - 1);
+	return frame;
+}
+
+void GDScriptFunction::_free_coroutine_frame(uint8_t *p_frame, uint32_t p_capacity) {
+	// Frames may be freed on another thread than the one that allocated them, they just change pools.
+	// Unpooled frames, and sizes that aren't a power of two, wrap around to a size class out of range.
+	const uint32_t size_class = uint32_t(get_shift_from_power_of_2(p_capacity) - int32_t(COROUTINE_FRAME_MIN_SHIFT));
+	if (size_class < COROUTINE_FRAME_SIZE_CLASSES) {
+		LocalVector<uint8_t *> &frames = coroutine_frame_pool.free_frames[size_class];
+		if (frames.size() < (COROUTINE_FRAME_POOL_BYTES >> (COROUTINE_FRAME_MIN_SHIFT + size_class))) {
+			frames.push_back(p_frame);
+			return;
+		}
+	}
+	Memory::free_static(p_frame);
+}
 
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
@@ -104,8 +156,15 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+void GDScriptFunction::_init_call_site_caches(int p_count) {
+	ERR_FAIL_COND(_call_site_caches != nullptr);
+	_call_site_count = p_count;
+	_call_site_caches = memnew_arr(CallSiteCache, p_count);
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
+	invalidate_call_site_caches();
 #ifdef DEBUG_ENABLED
 	{
 		MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
@@ -116,6 +175,12 @@ GDScriptFunction::GDScriptFunction() {
 
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
+	invalidate_call_site_caches();
+
+	if (_call_site_caches) {
+		memdelete_arr(_call_site_caches);
+	}
+	GDScriptJIT::free_code(_jit_code.load());
 
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
@@ -240,7 +305,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// First `GDScriptFunction::FIXED_ADDRESSES_MAX` stack addresses are special
 		// and not copied to the state, so we skip them here.
 		for (int i = GDScriptFunction::FIXED_ADDRESSES_MAX; i < state.stack_size; i++) {
@@ -278,4 +343,10 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+
+	// Only now, as `_clear_stack()` may run while the function is still executing on the frame.
+	_clear_stack();
+	if (state.stack) {
+		GDScriptFunction::_free_coroutine_frame(state.stack, state.stack_capacity);
+	}
 }
@@ -34,6 +34,7 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
@@ -42,6 +43,7 @@
 
 class GDScriptInstance;
 class GDScript;
+struct GDScriptJITCode;
 
 class GDScriptDataType {
 public:
@@ -265,6 +267,23 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		// Same layout as `OPCODE_OPERATOR_VALIDATED`, but evaluated inline on the values held by the slots.
+		OPCODE_ADD_INT,
+		OPCODE_SUBTRACT_INT,
+		OPCODE_MULTIPLY_INT,
+		OPCODE_EQUAL_INT,
+		OPCODE_LESS_INT,
+		OPCODE_GREATER_INT,
+		OPCODE_ADD_FLOAT,
+		OPCODE_SUBTRACT_FLOAT,
+		OPCODE_MULTIPLY_FLOAT,
+		OPCODE_DIVIDE_FLOAT,
+		OPCODE_LESS_FLOAT,
+		OPCODE_GREATER_FLOAT,
+		OPCODE_ADD_VECTOR3,
+		OPCODE_SUBTRACT_VECTOR3,
+		OPCODE_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -276,10 +295,16 @@ public:
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_SET_TYPED_ARRAY_INDEXED,
+		OPCODE_GET_TYPED_ARRAY_INDEXED,
+		OPCODE_SET_TYPED_DICTIONARY_KEYED,
+		OPCODE_GET_TYPED_DICTIONARY_KEYED,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
 		OPCODE_GET_NAMED_VALIDATED,
+		OPCODE_SET_NAMED_NATIVE,
+		OPCODE_GET_NAMED_NATIVE,
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
 		OPCODE_SET_STATIC_VARIABLE, // Only for GDScript.
@@ -452,8 +477,10 @@ public:
 
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptJIT;
 	friend class GDScriptLanguage;
 
 	StringName name;
@@ -530,6 +557,44 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Inline cache of an untyped `OPCODE_CALL*` site. It remembers what the method name resolved to
+	// for the last few receiver types seen there, so the VM can skip `Object::callp()`'s lookups.
+	// Entries are read without locking, so they are guarded by a sequence counter.
+	struct CallSiteCache {
+		static constexpr int ENTRY_COUNT = 4;
+
+		enum Kind : uint32_t {
+			KIND_FUNCTION,
+			KIND_METHOD_BIND,
+		};
+
+		struct Entry {
+			std::atomic<const void *> script = nullptr; // `GDScript *` of the receiver, or null if it has no script.
+			std::atomic<const void *> native = nullptr; // Unique pointer of the receiver's class name.
+			std::atomic<void *> target = nullptr;
+			std::atomic<uint32_t> kind = KIND_FUNCTION;
+			std::atomic<uint32_t> epoch = 0; // Never matches `call_site_cache_epoch`, which starts at 1.
+		};
+
+		std::atomic<uint32_t> sequence = 0;
+		uint32_t next_entry = 0; // Only touched by writers, under `call_site_cache_mutex`.
+		Entry entries[ENTRY_COUNT];
+	};
+
+	// Bumped whenever a function is created or freed, or a script is reloaded, so that no call site
+	// keeps dispatching to something that no longer matches what `Object::callp()` would find.
+	static SafeNumeric<uint32_t> call_site_cache_epoch;
+	static BinaryMutex call_site_cache_mutex;
+
+	int _call_site_count = 0;
+	CallSiteCache *_call_site_caches = nullptr;
+
+	// Native code tier, see `GDScriptJIT`. These stay untouched unless the engine is built with `gdscript_jit=yes`,
+	// but are always declared so the layout of this class doesn't depend on the build option.
+	SafeNumeric<uint32_t> _jit_call_count;
+	SafeFlag _jit_rejected;
+	std::atomic<GDScriptJITCode *> _jit_code = nullptr;
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -566,10 +631,20 @@ private:
 	String _get_call_error(const String &p_where, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
+	void _init_call_site_caches(int p_count);
+	bool _call_cached(int p_call_site, Object *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) const;
 
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
+	// Stacks saved by `await` are kept in frames recycled per thread, in power of two size classes.
+	static constexpr uint32_t COROUTINE_FRAME_MIN_SHIFT = 8; // 256 bytes.
+	static constexpr uint32_t COROUTINE_FRAME_SIZE_CLASSES = 10; // Up to 128 KiB, bigger frames aren't pooled.
+	static constexpr uint32_t COROUTINE_FRAME_POOL_BYTES = 1 << 20; // Bytes of free frames kept per size class and thread.
+
+	static uint8_t *_alloc_coroutine_frame(uint32_t p_size, uint32_t &r_capacity);
+	static void _free_coroutine_frame(uint8_t *p_frame, uint32_t p_capacity);
+
 	struct CallState {
 		Signal completed;
 		GDScript *script = nullptr;
@@ -578,7 +653,9 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Pooled frame, owned by the `GDScriptFunctionState`.
+		uint32_t stack_capacity = 0;
+		uint32_t alloca_size = 0;
 		int stack_size = 0;
 		int ip = 0;
 		int line = 0;
@@ -595,6 +672,7 @@ public:
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ int get_code_size() const { return _code_size; }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
@@ -607,6 +685,8 @@ public:
 	void disassemble(const Vector<String> &p_code_lines) const;
 #endif
 
+	static void invalidate_call_site_caches() { call_site_cache_epoch.increment(); }
+
 	GDScriptFunction();
 	~GDScriptFunction();
 };
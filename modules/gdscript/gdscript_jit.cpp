@@ -0,0 +1,595 @@
+/**************************************************************************/
+/*  gdscript_jit.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_jit.h"
+
+#include "gdscript_function.h"
+
+#ifdef GDSCRIPT_JIT_ENABLED
+#include "core/templates/local_vector.h"
+#include "core/variant/variant_internal.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if !defined(__x86_64__)
+#error "The GDScript JIT only supports x86_64."
+#endif
+#endif // GDSCRIPT_JIT_ENABLED
+
+uint32_t GDScriptJIT::call_threshold = GDScriptJIT::DEFAULT_CALL_THRESHOLD;
+SafeNumeric<uint32_t> GDScriptJIT::translated_function_count;
+
+#ifdef GDSCRIPT_JIT_ENABLED
+
+struct GDScriptJITCode {
+	GDScriptJIT::EntryPoint entry = nullptr;
+	void *memory = nullptr;
+	size_t size = 0;
+	bool uses_members = false; // Such code can't run when the function is called without an instance.
+};
+
+static BinaryMutex jit_compile_mutex;
+
+// Instructions that are not worth emitting inline call these helpers.
+// Conditions are returned as `uint32_t` so the generated code can test the whole register.
+
+static void _jit_assign(Variant *p_dst, const Variant *p_src) {
+	*p_dst = *p_src;
+}
+
+static void _jit_assign_null(Variant *p_dst) {
+	*p_dst = Variant();
+}
+
+static void _jit_assign_true(Variant *p_dst) {
+	*p_dst = true;
+}
+
+static void _jit_assign_false(Variant *p_dst) {
+	*p_dst = false;
+}
+
+static uint32_t _jit_booleanize(const Variant *p_value) {
+	return p_value->booleanize() ? 1 : 0;
+}
+
+static uint32_t _jit_get_bool(const Variant *p_value) {
+	return *VariantInternal::get_bool(p_value) ? 1 : 0;
+}
+
+template <typename T>
+static uint64_t _jit_address_of(T p_function) {
+	return (uint64_t)reinterpret_cast<uintptr_t>(p_function);
+}
+
+// Emits the machine code of a translated function. Each operand base of the VM address table is
+// kept in a callee-saved register, and pointers to operands are computed as base plus offset.
+class GDScriptJITAssembler {
+public:
+	enum Base {
+		BASE_STACK,
+		BASE_CONSTANTS,
+		BASE_MEMBERS,
+		BASE_RETURN, // Pointer to the return value of the VM.
+		BASE_FRAME, // Native stack area for the argument pointers of calls, like the VM's `instruction_args`.
+	};
+
+	// Bounds the native stack area reserved by `begin()`.
+	static constexpr int MAX_FRAME_SLOTS = 510;
+
+private:
+	struct Fixup {
+		uint32_t position = 0;
+		int target = 0; // Bytecode position.
+	};
+
+	LocalVector<uint8_t> code;
+	LocalVector<int64_t> labels; // Native offset of each bytecode position, or -1 if it isn't the start of an instruction.
+	LocalVector<Fixup> fixups;
+	uint32_t frame_size = 0;
+
+	void _emit8(uint8_t p_value) {
+		code.push_back(p_value);
+	}
+
+	void _emit32(uint32_t p_value) {
+		for (int i = 0; i < 4; i++) {
+			code.push_back((p_value >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void _emit64(uint64_t p_value) {
+		for (int i = 0; i < 8; i++) {
+			code.push_back((p_value >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void _jump(int p_target, bool p_conditional);
+
+	static constexpr uint8_t ARGUMENT_REGISTERS[] = { 7, 6, 2, 1 }; // rdi, rsi, rdx, rcx.
+
+	static uint8_t _base_register(Base p_base) {
+		static constexpr uint8_t registers[] = { 3, 12, 13, 14, 4 }; // rbx, r12, r13, r14, rsp.
+		return registers[p_base];
+	}
+
+	void _lea(uint8_t p_dst, uint8_t p_base, int32_t p_offset) {
+		_emit8(0x48 | (p_dst >= 8 ? 0x04 : 0) | (p_base >= 8 ? 0x01 : 0));
+		_emit8(0x8D);
+		_emit8(0x80 | ((p_dst & 7) << 3) | (p_base & 7));
+		if ((p_base & 7) == 4) {
+			_emit8(0x24); // SIB byte, needed for rsp and r12.
+		}
+		_emit32(p_offset);
+	}
+
+public:
+	bool begin(int p_code_size, int p_frame_slots);
+	void bind(int p_ip) { labels[p_ip] = code.size(); }
+
+	void load_address(int p_argument, Base p_base, int32_t p_offset);
+	void store_address(Base p_base, int32_t p_offset, int p_frame_slot);
+	void load_int(int p_argument, int32_t p_value);
+	void call(uint64_t p_function);
+	void jump(int p_target) { _jump(p_target, false); }
+	// Jumps if the last call returned zero.
+	void jump_if_zero(int p_target) { _jump(p_target, true); }
+	void jump_if_not_zero(int p_target);
+	void leave();
+
+	bool finish();
+	const LocalVector<uint8_t> &get_code() const { return code; }
+};
+
+bool GDScriptJITAssembler::begin(int p_code_size, int p_frame_slots) {
+	if (p_frame_slots < 0 || p_frame_slots > MAX_FRAME_SLOTS) {
+		return false;
+	}
+	labels.resize(p_code_size + 1);
+	for (int64_t &label : labels) {
+		label = -1;
+	}
+	// Call sites must see a 16 bytes aligned stack.
+	frame_size = (p_frame_slots * sizeof(void *) + 15) & ~15;
+
+	frame_size += 8; // The four pushes below and the return address leave the stack 8 bytes off.
+	_emit8(0x53); // push rbx
+	_emit8(0x41), _emit8(0x54); // push r12
+	_emit8(0x41), _emit8(0x55); // push r13
+	_emit8(0x41), _emit8(0x56); // push r14
+	_emit8(0x48), _emit8(0x81), _emit8(0xEC), _emit32(frame_size); // sub rsp, frame_size
+	_emit8(0x48), _emit8(0x8B), _emit8(0x1F); // mov rbx, [rdi]
+	_emit8(0x4C), _emit8(0x8B), _emit8(0x67), _emit8(0x08); // mov r12, [rdi + 8]
+	_emit8(0x4C), _emit8(0x8B), _emit8(0x6F), _emit8(0x10); // mov r13, [rdi + 16]
+	_emit8(0x49), _emit8(0x89), _emit8(0xF6); // mov r14, rsi
+	return true;
+}
+
+void GDScriptJITAssembler::load_address(int p_argument, Base p_base, int32_t p_offset) {
+	_lea(ARGUMENT_REGISTERS[p_argument], _base_register(p_base), p_offset);
+}
+
+void GDScriptJITAssembler::store_address(Base p_base, int32_t p_offset, int p_frame_slot) {
+	const int32_t frame_offset = p_frame_slot * sizeof(void *);
+	_lea(0, _base_register(p_base), p_offset); // lea rax, [base + offset]
+	_emit8(0x48), _emit8(0x89), _emit8(0x84), _emit8(0x24), _emit32(frame_offset); // mov [rsp + frame_offset], rax
+}
+
+void GDScriptJITAssembler::load_int(int p_argument, int32_t p_value) {
+	_emit8(0xB8 + ARGUMENT_REGISTERS[p_argument]), _emit32(p_value); // mov e.., value
+}
+
+void GDScriptJITAssembler::call(uint64_t p_function) {
+	_emit8(0x48), _emit8(0xB8), _emit64(p_function); // mov rax, function
+	_emit8(0xFF), _emit8(0xD0); // call rax
+}
+
+void GDScriptJITAssembler::_jump(int p_target, bool p_conditional) {
+	Fixup fixup;
+	fixup.target = p_target;
+	if (p_conditional) {
+		_emit8(0x85), _emit8(0xC0); // test eax, eax
+		_emit8(0x0F), _emit8(0x84); // jz rel32
+	} else {
+		_emit8(0xE9); // jmp rel32
+	}
+	fixup.position = code.size();
+	_emit32(0);
+	fixups.push_back(fixup);
+}
+
+void GDScriptJITAssembler::jump_if_not_zero(int p_target) {
+	// Branch over an unconditional jump, so `finish()` only patches rel32 displacements.
+	_emit8(0x85), _emit8(0xC0); // test eax, eax
+	_emit8(0x74), _emit8(0x05); // jz +5
+	_jump(p_target, false);
+}
+
+void GDScriptJITAssembler::leave() {
+	_emit8(0x48), _emit8(0x81), _emit8(0xC4), _emit32(frame_size); // add rsp, frame_size
+	_emit8(0x41), _emit8(0x5E); // pop r14
+	_emit8(0x41), _emit8(0x5D); // pop r13
+	_emit8(0x41), _emit8(0x5C); // pop r12
+	_emit8(0x5B); // pop rbx
+	_emit8(0xC3); // ret
+}
+
+bool GDScriptJITAssembler::finish() {
+	for (const Fixup &fixup : fixups) {
+		if (fixup.target < 0 || fixup.target >= (int)labels.size() || labels[fixup.target] < 0) {
+			return false; // Not the start of an instruction.
+		}
+		const int64_t displacement = labels[fixup.target] - (int64_t)(fixup.position + 4);
+		if (displacement < INT32_MIN || displacement > INT32_MAX) {
+			return false;
+		}
+		for (int i = 0; i < 4; i++) {
+			code[fixup.position + i] = ((uint32_t)displacement >> (i * 8)) & 0xFF;
+		}
+	}
+	return true;
+}
+
+GDScriptJITCode *GDScriptJIT::_translate(const GDScriptFunction *p_function) {
+	const int *code_ptr = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+	if (!code_ptr || code_size <= 0) {
+		return nullptr;
+	}
+
+	GDScriptJITAssembler assembler;
+	if (!assembler.begin(code_size, p_function->_instruction_args_size)) {
+		return nullptr;
+	}
+
+	bool uses_members = false;
+
+	// Resolves an operand address to the base register holding it and its offset from there.
+	auto resolve = [&](int p_address, GDScriptJITAssembler::Base &r_base, int32_t &r_offset) -> bool {
+		const int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		const int index = p_address & GDScriptFunction::ADDR_MASK;
+		switch (type) {
+			case GDScriptFunction::ADDR_TYPE_STACK: {
+				if (index >= p_function->_stack_size) {
+					return false;
+				}
+				r_base = GDScriptJITAssembler::BASE_STACK;
+			} break;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT: {
+				if (index >= p_function->_constant_count) {
+					return false;
+				}
+				r_base = GDScriptJITAssembler::BASE_CONSTANTS;
+			} break;
+			case GDScriptFunction::ADDR_TYPE_MEMBER: {
+				if (p_function->_static) {
+					return false;
+				}
+				uses_members = true;
+				r_base = GDScriptJITAssembler::BASE_MEMBERS;
+			} break;
+			default: {
+				return false;
+			}
+		}
+		r_offset = index * (int32_t)sizeof(Variant);
+		return true;
+	};
+
+	auto load = [&](int p_argument, int p_address) -> bool {
+		GDScriptJITAssembler::Base base;
+		int32_t offset;
+		if (!resolve(p_address, base, offset)) {
+			return false;
+		}
+		assembler.load_address(p_argument, base, offset);
+		return true;
+	};
+
+	int ip = 0;
+	while (ip < code_size) {
+		assembler.bind(ip);
+
+		switch (code_ptr[ip]) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			// Typed operators keep the validated evaluator, which is just as fast once called from native code.
+			case GDScriptFunction::OPCODE_ADD_INT:
+			case GDScriptFunction::OPCODE_SUBTRACT_INT:
+			case GDScriptFunction::OPCODE_MULTIPLY_INT:
+			case GDScriptFunction::OPCODE_EQUAL_INT:
+			case GDScriptFunction::OPCODE_LESS_INT:
+			case GDScriptFunction::OPCODE_GREATER_INT:
+			case GDScriptFunction::OPCODE_ADD_FLOAT:
+			case GDScriptFunction::OPCODE_SUBTRACT_FLOAT:
+			case GDScriptFunction::OPCODE_MULTIPLY_FLOAT:
+			case GDScriptFunction::OPCODE_DIVIDE_FLOAT:
+			case GDScriptFunction::OPCODE_LESS_FLOAT:
+			case GDScriptFunction::OPCODE_GREATER_FLOAT:
+			case GDScriptFunction::OPCODE_ADD_VECTOR3:
+			case GDScriptFunction::OPCODE_SUBTRACT_VECTOR3:
+			case GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT: {
+				const bool jump_if_not = code_ptr[ip] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+				const int size = jump_if_not ? 6 : 5;
+				if (ip + size > code_size) {
+					return nullptr;
+				}
+				const int operator_idx = code_ptr[ip + 4];
+				if (operator_idx < 0 || operator_idx >= p_function->_operator_funcs_count) {
+					return nullptr;
+				}
+				if (!load(0, code_ptr[ip + 1]) || !load(1, code_ptr[ip + 2]) || !load(2, code_ptr[ip + 3])) {
+					return nullptr;
+				}
+				assembler.call(_jit_address_of(p_function->_operator_funcs_ptr[operator_idx]));
+				if (jump_if_not) {
+					load(0, code_ptr[ip + 3]);
+					assembler.call(_jit_address_of(&_jit_get_bool));
+					assembler.jump_if_zero(code_ptr[ip + 5]);
+				}
+				ip += size;
+			} break;
+
+			case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+			case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+				if (ip + 4 > code_size) {
+					return nullptr;
+				}
+				const int index = code_ptr[ip + 3];
+				uint64_t function;
+				if (code_ptr[ip] == GDScriptFunction::OPCODE_SET_NAMED_VALIDATED) {
+					if (index < 0 || index >= p_function->_setters_count) {
+						return nullptr;
+					}
+					function = _jit_address_of(p_function->_setters_ptr[index]);
+				} else {
+					if (index < 0 || index >= p_function->_getters_count) {
+						return nullptr;
+					}
+					function = _jit_address_of(p_function->_getters_ptr[index]);
+				}
+				if (!load(0, code_ptr[ip + 1]) || !load(1, code_ptr[ip + 2])) {
+					return nullptr;
+				}
+				assembler.call(function);
+				ip += 4;
+			} break;
+
+			case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+				if (ip + 2 > code_size) {
+					return nullptr;
+				}
+				const int opcode = code_ptr[ip];
+				const int instr_arg_count = code_ptr[ip + 1];
+				if (instr_arg_count < 1 || instr_arg_count > p_function->_instruction_args_size || ip + 4 + instr_arg_count > code_size) {
+					return nullptr;
+				}
+				const int *instr_args = &code_ptr[ip + 2];
+				const int argc = code_ptr[ip + 2 + instr_arg_count];
+				const int index = code_ptr[ip + 3 + instr_arg_count];
+				// The base and the return value follow the arguments.
+				const int extra_args = opcode == GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED ? 2 : 1;
+				if (argc < 0 || argc > UINT16_MAX || argc + extra_args > instr_arg_count) {
+					return nullptr;
+				}
+
+				// The argument pointers go to the native frame, like the VM does with `instruction_args`.
+				for (int i = 0; i < argc; i++) {
+					GDScriptJITAssembler::Base base;
+					int32_t offset;
+					if (!resolve(instr_args[i], base, offset)) {
+						return nullptr;
+					}
+					assembler.store_address(base, offset, i);
+				}
+
+				if (opcode == GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED) {
+					if (index < 0 || index >= p_function->_constructors_count || !load(0, instr_args[argc])) {
+						return nullptr;
+					}
+					assembler.load_address(1, GDScriptJITAssembler::BASE_FRAME, 0);
+					assembler.call(_jit_address_of(p_function->_constructors_ptr[index]));
+				} else if (opcode == GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED) {
+					if (index < 0 || index >= p_function->_utilities_count || !load(0, instr_args[argc])) {
+						return nullptr;
+					}
+					assembler.load_address(1, GDScriptJITAssembler::BASE_FRAME, 0);
+					assembler.load_int(2, argc);
+					assembler.call(_jit_address_of(p_function->_utilities_ptr[index]));
+				} else {
+					if (index < 0 || index >= p_function->_builtin_methods_count || !load(0, instr_args[argc]) || !load(3, instr_args[argc + 1])) {
+						return nullptr;
+					}
+					assembler.load_address(1, GDScriptJITAssembler::BASE_FRAME, 0);
+					assembler.load_int(2, argc);
+					assembler.call(_jit_address_of(p_function->_builtin_methods_ptr[index]));
+				}
+				ip += 4 + instr_arg_count;
+			} break;
+
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				if (ip + 3 > code_size || !load(0, code_ptr[ip + 1]) || !load(1, code_ptr[ip + 2])) {
+					return nullptr;
+				}
+				assembler.call(_jit_address_of(&_jit_assign));
+				ip += 3;
+			} break;
+
+			case GDScriptFunction::OPCODE_ASSIGN_NULL:
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				if (ip + 2 > code_size || !load(0, code_ptr[ip + 1])) {
+					return nullptr;
+				}
+				if (code_ptr[ip] == GDScriptFunction::OPCODE_ASSIGN_NULL) {
+					assembler.call(_jit_address_of(&_jit_assign_null));
+				} else if (code_ptr[ip] == GDScriptFunction::OPCODE_ASSIGN_TRUE) {
+					assembler.call(_jit_address_of(&_jit_assign_true));
+				} else {
+					assembler.call(_jit_address_of(&_jit_assign_false));
+				}
+				ip += 2;
+			} break;
+
+			case GDScriptFunction::OPCODE_JUMP: {
+				if (ip + 2 > code_size) {
+					return nullptr;
+				}
+				assembler.jump(code_ptr[ip + 1]);
+				ip += 2;
+			} break;
+
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				if (ip + 3 > code_size || !load(0, code_ptr[ip + 1])) {
+					return nullptr;
+				}
+				assembler.call(_jit_address_of(&_jit_booleanize));
+				if (code_ptr[ip] == GDScriptFunction::OPCODE_JUMP_IF) {
+					assembler.jump_if_not_zero(code_ptr[ip + 2]);
+				} else {
+					assembler.jump_if_zero(code_ptr[ip + 2]);
+				}
+				ip += 3;
+			} break;
+
+			case GDScriptFunction::OPCODE_LINE: {
+				// Only needed by the debugger, and translated code doesn't run while it is active.
+				ip += 2;
+			} break;
+
+			case GDScriptFunction::OPCODE_RETURN: {
+				if (ip + 2 > code_size || !load(1, code_ptr[ip + 1])) {
+					return nullptr;
+				}
+				assembler.load_address(0, GDScriptJITAssembler::BASE_RETURN, 0);
+				assembler.call(_jit_address_of(&_jit_assign));
+				assembler.leave();
+				ip += 2;
+			} break;
+
+			case GDScriptFunction::OPCODE_END: {
+				assembler.leave();
+				ip += 1;
+			} break;
+
+			default: {
+				// Anything else may need type checks, error reporting or `await`, which only the VM handles.
+				return nullptr;
+			}
+		}
+	}
+
+	assembler.bind(code_size);
+	assembler.leave();
+
+	if (!assembler.finish()) {
+		return nullptr;
+	}
+
+	const LocalVector<uint8_t> &bytes = assembler.get_code();
+	const size_t page_size = sysconf(_SC_PAGESIZE);
+	const size_t size = (bytes.size() + page_size - 1) / page_size * page_size;
+
+	void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	ERR_FAIL_COND_V_MSG(memory == MAP_FAILED, nullptr, "Could not allocate memory for GDScript native code.");
+	memcpy(memory, bytes.ptr(), bytes.size());
+	if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+		munmap(memory, size);
+		ERR_FAIL_V_MSG(nullptr, "Could not make GDScript native code executable.");
+	}
+
+	GDScriptJITCode *jit_code = memnew(GDScriptJITCode);
+	jit_code->entry = reinterpret_cast<EntryPoint>(memory);
+	jit_code->memory = memory;
+	jit_code->size = size;
+	jit_code->uses_members = uses_members;
+	return jit_code;
+}
+
+bool GDScriptJIT::is_supported() {
+	return true;
+}
+
+GDScriptJIT::EntryPoint GDScriptJIT::get_entry_point(GDScriptFunction *p_function, bool p_has_instance) {
+	GDScriptJITCode *jit_code = p_function->_jit_code.load(std::memory_order_acquire);
+	if (unlikely(!jit_code)) {
+		if (p_function->_jit_rejected.is_set() || p_function->_jit_call_count.increment() < call_threshold) {
+			return nullptr;
+		}
+
+		MutexLock lock(jit_compile_mutex);
+		jit_code = p_function->_jit_code.load(std::memory_order_acquire);
+		if (!jit_code) {
+			if (p_function->_jit_rejected.is_set()) {
+				return nullptr;
+			}
+			jit_code = _translate(p_function);
+			if (!jit_code) {
+				p_function->_jit_rejected.set();
+				return nullptr;
+			}
+			p_function->_jit_code.store(jit_code, std::memory_order_release);
+			translated_function_count.increment();
+		}
+	}
+
+	// Let the VM report the error when members are used without an instance.
+	if (jit_code->uses_members && !p_has_instance) {
+		return nullptr;
+	}
+	return jit_code->entry;
+}
+
+void GDScriptJIT::free_code(GDScriptJITCode *p_code) {
+	if (!p_code) {
+		return;
+	}
+	munmap(p_code->memory, p_code->size);
+	memdelete(p_code);
+}
+
+#else // !GDSCRIPT_JIT_ENABLED
+
+bool GDScriptJIT::is_supported() {
+	return false;
+}
+
+GDScriptJIT::EntryPoint GDScriptJIT::get_entry_point(GDScriptFunction *p_function, bool p_has_instance) {
+	return nullptr;
+}
+
+void GDScriptJIT::free_code(GDScriptJITCode *p_code) {
+}
+
+#endif // GDSCRIPT_JIT_ENABLED
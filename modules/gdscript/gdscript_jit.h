@@ -0,0 +1,77 @@
+/**************************************************************************/
+/*  gdscript_jit.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/safe_refcount.h"
+#include "core/typedefs.h"
+
+#if defined(GDSCRIPT_JIT_ENABLED) && !(defined(__GNUC__) || defined(__clang__))
+#error "The GDScript JIT relies on the computed goto dispatch of the VM, which needs GCC or Clang."
+#endif
+
+class GDScriptFunction;
+class Variant;
+
+struct GDScriptJITCode;
+
+// Optional native code tier for the GDScript VM, enabled with the `gdscript_jit=yes` build option.
+// Functions are counted as they get called and, once past the call threshold, their bytecode is
+// translated to x86_64 machine code. Only functions made entirely of validated instructions
+// (whose operand types were known at compile time) are translated, so the generated code never has to
+// check types or report errors: every instruction becomes a direct call to the same evaluator the VM
+// would use. Any other function keeps running in the VM.
+class GDScriptJIT {
+public:
+	// Receives the VM address table (stack, constants and members) and where to write the return value.
+	typedef void (*EntryPoint)(Variant *const *p_addresses, Variant *r_return);
+
+private:
+	static uint32_t call_threshold;
+	static SafeNumeric<uint32_t> translated_function_count;
+
+	static GDScriptJITCode *_translate(const GDScriptFunction *p_function);
+
+public:
+	static constexpr uint32_t DEFAULT_CALL_THRESHOLD = 1000;
+
+	static bool is_supported();
+
+	// Number of calls after which a function gets translated. Zero translates functions on their first call.
+	static void set_call_threshold(uint32_t p_threshold) { call_threshold = p_threshold; }
+	static uint32_t get_call_threshold() { return call_threshold; }
+
+	// Number of functions translated to native code so far.
+	static uint32_t get_translated_function_count() { return translated_function_count.get(); }
+
+	// Returns the native code of the function, translating it if it just became hot, or null if it must run in the VM.
+	static EntryPoint get_entry_point(GDScriptFunction *p_function, bool p_has_instance);
+	static void free_code(GDScriptJITCode *p_code);
+};
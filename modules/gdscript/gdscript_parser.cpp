@@ -791,10 +791,22 @@ Ref<GDScriptParserRef> GDScriptParser::get_depended_parser_for(const String &p_p
 	return ref;
 }
 
-const HashMap<String, Ref<GDScriptParserRef>> &GDScriptParser::get_depended_parsers() {
+const HashMap<String, Ref<GDScriptParserRef>> &GDScriptParser::get_depended_parsers() const {
 	return depended_parsers;
 }
 
+void GDScriptParser::_add_referenced_script_path(const String &p_path) {
+	if (p_path.is_empty()) {
+		return;
+	}
+	// Resolved the same way as the analyzer does for `extends` and `preload()`.
+	if (p_path.is_relative_path()) {
+		referenced_script_paths.insert(script_path.get_base_dir().path_join(p_path).simplify_path());
+	} else {
+		referenced_script_paths.insert(p_path.simplify_path());
+	}
+}
+
 GDScriptParser::ClassNode *GDScriptParser::find_class(const String &p_qualified_name) const {
 	String first = p_qualified_name.get_slice("::", 0);
 
@@ -920,6 +932,7 @@ void GDScriptParser::parse_extends() {
 			push_error(vformat(R"(Only strings or identifiers can be used after "extends", found "%s" instead.)", Variant::get_type_name(previous.literal.get_type())));
 		}
 		current_class->extends_path = previous.literal;
+		_add_referenced_script_path(current_class->extends_path);
 
 		if (!match(GDScriptTokenizer::Token::PERIOD)) {
 			return;
@@ -2763,6 +2776,9 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_identifier(ExpressionNode
 			case SuiteNode::Local::UNDEFINED:
 				ERR_FAIL_V_MSG(nullptr, "Undefined local found.");
 		}
+	} else {
+		// May name a global class; see `GDScriptCache::parse_dependencies()`.
+		referenced_identifiers.insert(identifier->name);
 	}
 
 	return identifier;
@@ -3591,6 +3607,10 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_preload(ExpressionNode *p_
 		push_error(R"(Expected resource path after "(".)");
 	} else if (preload->path->type == Node::LITERAL) {
 		override_completion_context(preload->path, COMPLETION_RESOURCE_PATH, preload);
+		const Variant &path = static_cast<LiteralNode *>(preload->path)->value;
+		if (path.get_type() == Variant::STRING && String(path).get_extension() == GDScriptLanguage::get_singleton()->get_extension()) {
+			_add_referenced_script_path(path);
+		}
 	}
 
 	pop_completion_call();
@@ -1333,6 +1333,7 @@ public:
 private:
 	friend class GDScriptAnalyzer;
 	friend class GDScriptParserRef;
+	friend class GDScriptCache;
 
 	bool _is_tool = false;
 	String script_path;
@@ -1343,6 +1344,11 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	// Scripts this one may depend on, gathered while parsing so they can be parsed ahead of analysis.
+	HashSet<String> referenced_script_paths;
+	HashSet<StringName> referenced_identifiers;
+	// Keeps the parsers from `GDScriptCache::parse_dependencies()` alive until analysis claims them.
+	LocalVector<Ref<GDScriptParserRef>> prefetched_parsers;
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1474,6 +1480,7 @@ private:
 
 	void clear();
 	void push_error(const String &p_message, const Node *p_origin = nullptr);
+	void _add_referenced_script_path(const String &p_path);
 #ifdef DEBUG_ENABLED
 	void push_warning(const Node *p_source, GDScriptWarning::Code p_code, const Vector<String> &p_symbols);
 	template <typename... Symbols>
@@ -1601,7 +1608,9 @@ public:
 	ClassNode *get_tree() const { return head; }
 	bool is_tool() const { return _is_tool; }
 	Ref<GDScriptParserRef> get_depended_parser_for(const String &p_path);
-	const HashMap<String, Ref<GDScriptParserRef>> &get_depended_parsers();
+	const HashMap<String, Ref<GDScriptParserRef>> &get_depended_parsers() const;
+	const HashSet<String> &get_referenced_script_paths() const { return referenced_script_paths; }
+	const HashSet<StringName> &get_referenced_identifiers() const { return referenced_identifiers; }
 	ClassNode *find_class(const String &p_qualified_name) const;
 	bool has_class(const GDScriptParser::ClassNode *p_class) const;
 	static Variant::Type get_builtin_type(const StringName &p_type); // Excluding `Variant::NIL` and `Variant::OBJECT`.
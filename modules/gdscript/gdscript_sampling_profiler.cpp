@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript.h"
+
+#include "core/config/engine.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/os/os.h"
+
+void GDScriptSamplingProfiler::_thread_func(void *p_userdata) {
+	GDScriptSamplingProfiler *profiler = static_cast<GDScriptSamplingProfiler *>(p_userdata);
+	while (profiler->sampling.is_set()) {
+		OS::get_singleton()->delay_usec(profiler->interval_usec);
+		GDScriptLanguage::get_singleton()->request_sample();
+	}
+}
+
+void GDScriptSamplingProfiler::_send_samples() {
+	GDScriptLanguage::get_singleton()->take_folded_samples(samples);
+	if (samples.is_empty() || !EngineDebugger::is_active()) {
+		return;
+	}
+
+	Array arr = { Engine::get_singleton()->get_process_frames(), interval_usec, samples.size() * 2 };
+	for (const KeyValue<String, uint64_t> &E : samples) {
+		arr.push_back(E.key);
+		arr.push_back(E.value);
+	}
+	EngineDebugger::get_singleton()->send_message("gdscript_sampler:samples", arr);
+}
+
+void GDScriptSamplingProfiler::toggle(bool p_enable, const Array &p_opts) {
+	if (p_enable) {
+		if (sampling.is_set()) {
+			return;
+		}
+		interval_usec = DEFAULT_INTERVAL_USEC;
+		if (p_opts.size() > 0 && p_opts[0].get_type() == Variant::INT) {
+			interval_usec = MAX(MIN_INTERVAL_USEC, uint64_t(p_opts[0]));
+		}
+		// Drop samples left over from a previous session.
+		GDScriptLanguage::get_singleton()->take_folded_samples(samples);
+		sampling.set();
+		GDScriptLanguage::get_singleton()->set_sampling_active(true);
+		thread.start(&GDScriptSamplingProfiler::_thread_func, this);
+	} else {
+		if (!sampling.is_set()) {
+			return;
+		}
+		sampling.clear();
+		GDScriptLanguage::get_singleton()->set_sampling_active(false);
+		thread.wait_to_finish();
+		_send_samples();
+	}
+}
+
+void GDScriptSamplingProfiler::tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
+	_send_samples();
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	if (sampling.is_set()) {
+		sampling.clear();
+		GDScriptLanguage::get_singleton()->set_sampling_active(false);
+		thread.wait_to_finish();
+	}
+}
+
+#endif // DEBUG_ENABLED
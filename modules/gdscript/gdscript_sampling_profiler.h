@@ -0,0 +1,66 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG_ENABLED
+
+#include "core/debugger/engine_profiler.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+// Low overhead alternative to the instrumenting "servers" script profiler.
+// Sends the call stacks of running script code, sampled at a fixed interval,
+// as folded stacks ("frame;frame;frame" and a sample count) every frame.
+//
+// Only available in debug builds, where threads take their samples on `OPCODE_LINE`.
+// Functions running as native code through the JIT are not sampled, and a long native
+// call is counted once it returns, on the next line of the function that made it.
+class GDScriptSamplingProfiler : public EngineProfiler {
+	Thread thread;
+	SafeFlag sampling;
+	uint64_t interval_usec = DEFAULT_INTERVAL_USEC;
+	HashMap<String, uint64_t> samples;
+
+	static void _thread_func(void *p_userdata);
+	void _send_samples();
+
+public:
+	static constexpr uint64_t DEFAULT_INTERVAL_USEC = 1000;
+	static constexpr uint64_t MIN_INTERVAL_USEC = 100;
+
+	virtual void toggle(bool p_enable, const Array &p_opts) override;
+	virtual void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) override;
+
+	~GDScriptSamplingProfiler();
+};
+
+#endif // DEBUG_ENABLED
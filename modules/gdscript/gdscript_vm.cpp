@@ -30,9 +30,28 @@
 
 #include "gdscript.h"
 #include "gdscript_function.h"
+#include "gdscript_jit.h"
 #include "gdscript_lambda_callable.h"
 
+#include "core/config/engine.h"
 #include "core/os/os.h"
+#include "core/variant/variant_op.h"
+#include "scene/scene_string_names.h"
+
+// Object whose native property accessors can be called directly, skipping `Object::get()` and `Object::set()`.
+// Scripts and extension classes may intercept the access with `_get()` and `_set()`, so those (and null or
+// freed bases, for the error reporting) return `nullptr` and must use the generic path.
+static _FORCE_INLINE_ Object *_get_native_property_owner(Variant *p_base) {
+	if (unlikely(p_base->get_type() != Variant::OBJECT)) {
+		return nullptr;
+	}
+	// Validated in all builds, like `Variant::get_named()`, since the object may have been freed.
+	Object *obj = p_base->get_validated_object();
+	if (unlikely(obj == nullptr || obj->get_script_instance() != nullptr || obj->is_extension_instance())) {
+		return nullptr;
+	}
+	return obj;
+}
 
 #ifdef DEBUG_ENABLED
 
@@ -254,6 +273,22 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_ADD_INT,                                \
+		&&OPCODE_SUBTRACT_INT,                           \
+		&&OPCODE_MULTIPLY_INT,                           \
+		&&OPCODE_EQUAL_INT,                              \
+		&&OPCODE_LESS_INT,                               \
+		&&OPCODE_GREATER_INT,                            \
+		&&OPCODE_ADD_FLOAT,                              \
+		&&OPCODE_SUBTRACT_FLOAT,                         \
+		&&OPCODE_MULTIPLY_FLOAT,                         \
+		&&OPCODE_DIVIDE_FLOAT,                           \
+		&&OPCODE_LESS_FLOAT,                             \
+		&&OPCODE_GREATER_FLOAT,                          \
+		&&OPCODE_ADD_VECTOR3,                            \
+		&&OPCODE_SUBTRACT_VECTOR3,                       \
+		&&OPCODE_MULTIPLY_VECTOR3_FLOAT,                 \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -265,10 +300,16 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_KEYED,                              \
 		&&OPCODE_GET_KEYED_VALIDATED,                    \
 		&&OPCODE_GET_INDEXED_VALIDATED,                  \
+		&&OPCODE_SET_TYPED_ARRAY_INDEXED,                \
+		&&OPCODE_GET_TYPED_ARRAY_INDEXED,                \
+		&&OPCODE_SET_TYPED_DICTIONARY_KEYED,             \
+		&&OPCODE_GET_TYPED_DICTIONARY_KEYED,             \
 		&&OPCODE_SET_NAMED,                              \
 		&&OPCODE_SET_NAMED_VALIDATED,                    \
 		&&OPCODE_GET_NAMED,                              \
 		&&OPCODE_GET_NAMED_VALIDATED,                    \
+		&&OPCODE_SET_NAMED_NATIVE,                       \
+		&&OPCODE_GET_NAMED_NATIVE,                       \
 		&&OPCODE_SET_MEMBER,                             \
 		&&OPCODE_GET_MEMBER,                             \
 		&&OPCODE_SET_STATIC_VARIABLE,                    \
@@ -494,6 +535,106 @@ void (*type_init_function_table[])(Variant *) = {
 #define METHOD_CALL_ON_NULL_VALUE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a null value."
 #define METHOD_CALL_ON_FREED_INSTANCE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a previously freed instance."
 
+bool GDScriptFunction::_call_cached(int p_call_site, Object *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) const {
+	GDScriptInstance *instance = nullptr;
+	ScriptInstance *script_instance = p_base->get_script_instance();
+	if (script_instance) {
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+			return false;
+		}
+		instance = static_cast<GDScriptInstance *>(script_instance);
+	}
+
+	const void *script = instance ? instance->script.ptr() : nullptr;
+	const void *native = p_base->get_class_name().data_unique_pointer();
+	const uint32_t epoch = call_site_cache_epoch.get();
+	CallSiteCache &cache = _call_site_caches[p_call_site];
+
+	void *target = nullptr;
+	uint32_t kind = CallSiteCache::KIND_FUNCTION;
+
+	const uint32_t sequence = cache.sequence.load(std::memory_order_acquire);
+	if ((sequence & 1) == 0) {
+		for (const CallSiteCache::Entry &entry : cache.entries) {
+			if (entry.script.load(std::memory_order_relaxed) == script && entry.native.load(std::memory_order_relaxed) == native && entry.epoch.load(std::memory_order_relaxed) == epoch) {
+				target = entry.target.load(std::memory_order_relaxed);
+				kind = entry.kind.load(std::memory_order_relaxed);
+				break;
+			}
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (cache.sequence.load(std::memory_order_relaxed) != sequence) {
+			target = nullptr; // A writer got in the way, the entry may be torn.
+		}
+	}
+
+	if (unlikely(target == nullptr)) {
+		if (p_method == CoreStringName(free_) || p_method == SceneStringName(_ready)) {
+			return false; // `Object::callp()` and `GDScriptInstance::callp()` handle these specially.
+		}
+
+		// Resolve the method the same way `Object::callp()` would.
+		for (GDScript *sptr = instance ? instance->script.ptr() : nullptr; sptr; sptr = sptr->base.ptr()) {
+			if (likely(sptr->valid)) {
+				HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_method);
+				if (E) {
+					target = E->value;
+					break;
+				}
+			}
+		}
+
+		if (target == nullptr) {
+			const StringName &class_name = p_base->get_class_name();
+			ClassDB::APIType api = ClassDB::get_api_type(class_name);
+			if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+				return false; // Extensions can be reloaded, which frees their method binds.
+			}
+			target = ClassDB::get_method(class_name, p_method);
+			kind = CallSiteCache::KIND_METHOD_BIND;
+			if (target == nullptr) {
+				return false; // Let the regular path report the error.
+			}
+		}
+
+		MutexLock lock(call_site_cache_mutex);
+
+		// Prefer replacing an entry left over from an older epoch.
+		int slot = -1;
+		for (int i = 0; i < CallSiteCache::ENTRY_COUNT; i++) {
+			if (cache.entries[i].epoch.load(std::memory_order_relaxed) != epoch) {
+				slot = i;
+				break;
+			}
+		}
+		if (slot < 0) {
+			slot = cache.next_entry;
+			cache.next_entry = (cache.next_entry + 1) % CallSiteCache::ENTRY_COUNT;
+		}
+
+		CallSiteCache::Entry &entry = cache.entries[slot];
+		const uint32_t write_sequence = cache.sequence.load(std::memory_order_relaxed);
+		cache.sequence.store(write_sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		entry.script.store(script, std::memory_order_relaxed);
+		entry.native.store(native, std::memory_order_relaxed);
+		entry.target.store(target, std::memory_order_relaxed);
+		entry.kind.store(kind, std::memory_order_relaxed);
+		entry.epoch.store(epoch, std::memory_order_relaxed);
+		cache.sequence.store(write_sequence + 2, std::memory_order_release);
+	}
+
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(p_base); // Same as `Object::callp()`.
+#endif
+	if (kind == CallSiteCache::KIND_FUNCTION) {
+		r_ret = static_cast<GDScriptFunction *>(target)->call(instance, p_args, p_argcount, r_err);
+	} else {
+		r_ret = static_cast<MethodBind *>(target)->call(p_base, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	OPCODES_TABLE;
 
@@ -540,11 +681,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -737,6 +878,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	// Hot functions that only use validated instructions run as native code, which skips `OPCODE_LINE`,
+	// so the debugger always gets the VM. Resumed functions are never translated, since they use `await`.
+	bool run_native = !p_state && !EngineDebugger::is_active();
+#ifdef DEBUG_ENABLED
+	// Neither profiler sees inside native code: samples are taken on `OPCODE_LINE`, and native calls aren't timed.
+	run_native = run_native && !GDScriptLanguage::get_singleton()->profiling && !GDScriptLanguage::is_sampling_active();
+#endif
+	if (run_native) {
+		GDScriptJIT::EntryPoint jit_entry = GDScriptJIT::get_entry_point(this, p_instance != nullptr);
+		if (jit_entry) {
+			jit_entry(variant_addresses, &retvalue);
+			OPCODE_OUT;
+		}
+	}
+#endif // GDSCRIPT_JIT_ENABLED
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -747,7 +905,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		OPCODE_SWITCH(_code_ptr[ip]) {
 			OPCODE(OPCODE_OPERATOR) {
 				constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*_code_ptr);
-				CHECK_SPACE(7 + _pointer_size);
+				// Two cache entries follow the operator, each made of a signature, a return type and a function pointer.
+				constexpr int _cache_entry_size = 2 + _pointer_size;
+				CHECK_SPACE(5 + 2 * _cache_entry_size);
 
 				bool valid;
 				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 4];
@@ -758,6 +918,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(dst, 2);
 				// Compute signatures (types of operands) so it can be optimized when matching.
 				uint32_t op_signature = _code_ptr[ip + 5];
+				uint32_t op_signature_alt = _code_ptr[ip + 5 + _cache_entry_size];
 				uint32_t actual_signature = (a->get_type() << 8) | (b->get_type());
 
 #ifdef DEBUG_ENABLED
@@ -803,32 +964,65 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Variant::ValidatedOperatorEvaluator op_func = *reinterpret_cast<Variant::ValidatedOperatorEvaluator *>(&_code_ptr[ip + 7]);
 
 					// Make sure the return value has the correct type.
+					VariantInternal::initialize(dst, ret_type);
+					op_func(a, b, dst);
+				} else if (op_signature_alt != 0 && op_signature_alt == actual_signature) {
+					// An empty entry also has signature 0, same as `null` with `null`, so don't match it.
+					// Second most common signature, e.g. an untyped accumulator that starts as an int and becomes a float.
+					Variant::Type ret_type = static_cast<Variant::Type>(_code_ptr[ip + 6 + _cache_entry_size]);
+					Variant::ValidatedOperatorEvaluator op_func = *reinterpret_cast<Variant::ValidatedOperatorEvaluator *>(&_code_ptr[ip + 7 + _cache_entry_size]);
+
 					VariantInternal::initialize(dst, ret_type);
 					op_func(a, b, dst);
 				} else {
-					// If the signature doesn't match, we have to use the slow path.
+					Variant::Type a_type = (Variant::Type)((actual_signature >> 8) & 0xFF);
+					Variant::Type b_type = (Variant::Type)(actual_signature & 0xFF);
+					Variant::ValidatedOperatorEvaluator op_func = nullptr;
+					if (op_signature_alt == 0 && op_signature != 0xFFFF) {
+						op_func = Variant::get_validated_operator_evaluator(op, a_type, b_type);
+					}
+
+					if (op_func) {
+						// Fill the second cache entry the first time the site sees another valid signature.
+						static Mutex initializer_mutex;
+						MutexLock lock(initializer_mutex);
+
+						Variant::Type ret_type = Variant::get_operator_return_type(op, a_type, b_type);
+						VariantInternal::initialize(dst, ret_type);
+						op_func(a, b, dst);
+
+						// Check again in case another thread already set it.
+						if (_code_ptr[ip + 5 + _cache_entry_size] == 0) {
+							_code_ptr[ip + 5 + _cache_entry_size] = actual_signature;
+							_code_ptr[ip + 6 + _cache_entry_size] = static_cast<int>(ret_type);
+							Variant::ValidatedOperatorEvaluator *tmp = reinterpret_cast<Variant::ValidatedOperatorEvaluator *>(&_code_ptr[ip + 7 + _cache_entry_size]);
+							*tmp = op_func;
+						}
+					} else {
+						// If no signature matches, we have to use the slow path.
 #ifdef DEBUG_ENABLED
 
-					Variant ret;
-					Variant::evaluate(op, *a, *b, ret, valid);
+						Variant ret;
+						Variant::evaluate(op, *a, *b, ret, valid);
 #else
-					Variant::evaluate(op, *a, *b, *dst, valid);
+						Variant::evaluate(op, *a, *b, *dst, valid);
 #endif
 #ifdef DEBUG_ENABLED
-					if (!valid) {
-						if (ret.get_type() == Variant::STRING) {
-							//return a string when invalid with the error
-							err_text = ret;
-							err_text += " in operator '" + Variant::get_operator_name(op) + "'.";
-						} else {
-							err_text = "Invalid operands '" + Variant::get_type_name(a->get_type()) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
+						if (!valid) {
+							if (ret.get_type() == Variant::STRING) {
+								//return a string when invalid with the error
+								err_text = ret;
+								err_text += " in operator '" + Variant::get_operator_name(op) + "'.";
+							} else {
+								err_text = "Invalid operands '" + Variant::get_type_name(a->get_type()) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
+							}
+							OPCODE_BREAK;
 						}
-						OPCODE_BREAK;
-					}
-					*dst = ret;
+						*dst = ret;
 #endif
+					}
 				}
-				ip += 7 + _pointer_size;
+				ip += 5 + 2 * _cache_entry_size;
 			}
 			DISPATCH_OPCODE;
 
@@ -849,6 +1043,60 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				// The code generator only fuses operators that return `bool`.
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+// The code generator only emits these when both operands have the matching static type, and the
+// destination slot already holds a value of the result type. The validated evaluator is still
+// referenced at `ip + 4`, so they can be handled like `OPCODE_OPERATOR_VALIDATED` elsewhere.
+#define OPCODE_TYPED_OPERATOR(m_name, ...)          \
+	OPCODE(OPCODE_##m_name) {                       \
+		CHECK_SPACE(5);                             \
+		GET_VARIANT_PTR(a, 0);                      \
+		GET_VARIANT_PTR(b, 1);                      \
+		GET_VARIANT_PTR(dst, 2);                    \
+		__VA_ARGS__::validated_evaluate(a, b, dst); \
+		ip += 5;                                    \
+	}                                               \
+	DISPATCH_OPCODE
+
+			OPCODE_TYPED_OPERATOR(ADD_INT, OperatorEvaluatorAdd<int64_t, int64_t, int64_t>);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_INT, OperatorEvaluatorSub<int64_t, int64_t, int64_t>);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_INT, OperatorEvaluatorMul<int64_t, int64_t, int64_t>);
+			OPCODE_TYPED_OPERATOR(EQUAL_INT, OperatorEvaluatorEqual<int64_t, int64_t>);
+			OPCODE_TYPED_OPERATOR(LESS_INT, OperatorEvaluatorLess<int64_t, int64_t>);
+			OPCODE_TYPED_OPERATOR(GREATER_INT, OperatorEvaluatorGreater<int64_t, int64_t>);
+			OPCODE_TYPED_OPERATOR(ADD_FLOAT, OperatorEvaluatorAdd<double, double, double>);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_FLOAT, OperatorEvaluatorSub<double, double, double>);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_FLOAT, OperatorEvaluatorMul<double, double, double>);
+			OPCODE_TYPED_OPERATOR(DIVIDE_FLOAT, OperatorEvaluatorDiv<double, double, double>);
+			OPCODE_TYPED_OPERATOR(LESS_FLOAT, OperatorEvaluatorLess<double, double>);
+			OPCODE_TYPED_OPERATOR(GREATER_FLOAT, OperatorEvaluatorGreater<double, double>);
+			OPCODE_TYPED_OPERATOR(ADD_VECTOR3, OperatorEvaluatorAdd<Vector3, Vector3, Vector3>);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_VECTOR3, OperatorEvaluatorSub<Vector3, Vector3, Vector3>);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR3_FLOAT, OperatorEvaluatorMul<Vector3, Vector3, double>);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1192,6 +1440,114 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			// The analyzer proved the element type of these containers, and the codegen only uses the set
+			// opcodes when the value is of exactly that type, so the container type checks are skipped.
+			OPCODE(OPCODE_SET_TYPED_ARRAY_INDEXED) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(value, 2);
+
+				Array *array = VariantInternal::get_array(dst);
+				int64_t int_index = *VariantInternal::get_int(index);
+				const int64_t size = array->size();
+				if (int_index < 0) {
+					int_index += size;
+				}
+
+				if (unlikely(int_index < 0 || int_index >= size || array->is_read_only())) {
+#ifdef DEBUG_ENABLED
+					if (array->is_read_only()) {
+						err_text = "Invalid assignment on read-only value (on base: '" + _get_var_type(dst) + "').";
+					} else {
+						err_text = "Out of bounds set index '" + index->operator String() + "' (on base: '" + _get_var_type(dst) + "')";
+					}
+					OPCODE_BREAK;
+#endif
+				} else {
+					(*array)[int_index] = *value;
+				}
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_TYPED_ARRAY_INDEXED) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(index, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				const Array *array = VariantInternal::get_array(src);
+				int64_t int_index = *VariantInternal::get_int(index);
+				const int64_t size = array->size();
+				if (int_index < 0) {
+					int_index += size;
+				}
+
+				if (unlikely(int_index < 0 || int_index >= size)) {
+#ifdef DEBUG_ENABLED
+					err_text = "Out of bounds get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "')";
+					OPCODE_BREAK;
+#endif
+				} else {
+					*dst = (*array)[int_index];
+				}
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_SET_TYPED_DICTIONARY_KEYED) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(key, 1);
+				GET_VARIANT_PTR(value, 2);
+
+				Dictionary *dictionary = VariantInternal::get_dictionary(dst);
+				const bool valid = dictionary->set_unchecked(*key, *value);
+
+#ifdef DEBUG_ENABLED
+				if (!valid) {
+					err_text = "Invalid assignment on read-only value (on base: '" + _get_var_type(dst) + "').";
+					OPCODE_BREAK;
+				}
+#else
+				(void)valid;
+#endif
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_TYPED_DICTIONARY_KEYED) {
+				CHECK_SPACE(4);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(key, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				const Variant *value = VariantInternal::get_dictionary(src)->getptr_unchecked(*key);
+				if (likely(value)) {
+					*dst = *value;
+				} else {
+#ifdef DEBUG_ENABLED
+					String v = key->operator String();
+					if (!v.is_empty()) {
+						v = "'" + v + "'";
+					} else {
+						v = "of type '" + _get_var_type(key) + "'";
+					}
+					err_text = "Invalid access to property or key " + v + " on a base object of type '" + _get_var_type(src) + "'.";
+					OPCODE_BREAK;
+#else
+					*dst = Variant();
+#endif
+				}
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_NAMED) {
 				CHECK_SPACE(3);
 
@@ -1289,6 +1645,70 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_SET_NAMED_NATIVE) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(value, 1);
+
+				GD_ERR_BREAK(_code_ptr[ip + 3] < 0 || _code_ptr[ip + 3] >= _methods_count);
+				MethodBind *setter = _methods_ptr[_code_ptr[ip + 3]];
+
+				Object *obj = _get_native_property_owner(dst);
+				// `Object::set()` also flags edited objects, which the editor relies on.
+				if (likely(obj && !Engine::get_singleton()->is_editor_hint())) {
+					const Variant *args[1] = { value };
+					setter->validated_call(obj, args, nullptr);
+				} else {
+					int indexname = _code_ptr[ip + 4];
+					GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+					const StringName *index = &_global_names_ptr[indexname];
+
+					bool valid;
+					dst->set_named(*index, *value, valid);
+#ifdef DEBUG_ENABLED
+					if (!valid) {
+						err_text = "Invalid assignment of property or key '" + String(*index) + "' with value of type '" + _get_var_type(value) + "' on a base object of type '" + _get_var_type(dst) + "'.";
+						OPCODE_BREAK;
+					}
+#endif
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_NAMED_NATIVE) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(dst, 1);
+
+				GD_ERR_BREAK(_code_ptr[ip + 3] < 0 || _code_ptr[ip + 3] >= _methods_count);
+				MethodBind *getter = _methods_ptr[_code_ptr[ip + 3]];
+
+				Object *obj = _get_native_property_owner(src);
+				if (likely(obj)) {
+					// The destination was already adjusted to the getter return type.
+					getter->validated_call(obj, nullptr, dst);
+				} else {
+					int indexname = _code_ptr[ip + 4];
+					GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+					const StringName *index = &_global_names_ptr[indexname];
+
+					bool valid;
+					Variant ret = src->get_named(*index, valid);
+#ifdef DEBUG_ENABLED
+					if (!valid) {
+						err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
+						OPCODE_BREAK;
+					}
+#endif
+					*dst = ret;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_MEMBER) {
 				CHECK_SPACE(3);
 				GET_VARIANT_PTR(src, 0);
@@ -1893,7 +2313,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1904,6 +2324,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int call_site = _code_ptr[ip + 3];
+				GD_ERR_BREAK(call_site < 0 || call_site >= _call_site_count);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1918,11 +2341,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				StringName base_class = base_obj ? base_obj->get_class_name() : StringName();
 #endif
 
+#ifdef DEBUG_ENABLED
+				Object *call_obj = base_obj; // Freed objects go through `Variant::callp()`, which reports them.
+#else
+				Object *call_obj = base->get_type() == Variant::OBJECT ? *VariantInternal::get_object(base) : nullptr;
+#endif
+
 				Variant temp_ret;
 				Callable::CallError err;
+				if (call_obj == nullptr || !_call_cached(call_site, call_obj, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+				}
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1951,8 +2382,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
-				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -2007,7 +2436,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2573,13 +3002,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
-					for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
-					}
-					gdfs->state.stack_size = _stack_size;
 					gdfs->state.ip = ip + 2;
 					gdfs->state.line = line;
 					gdfs->state.script = _script;
@@ -2615,6 +3037,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						OPCODE_BREAK;
 					}
 
+					// Hand the stack over to the function state. The locals are moved, not copied, and a
+					// resumed function simply passes its frame on, so they stay in place across awaits.
+					// The stack must not be touched past this point, except for the reserved addresses.
+					if (p_state) {
+						gdfs->state.stack = p_state->stack;
+						gdfs->state.stack_capacity = p_state->stack_capacity;
+						p_state->stack = nullptr;
+						p_state->stack_capacity = 0;
+						p_state->stack_size = 0;
+					} else {
+						gdfs->state.stack = _alloc_coroutine_frame(alloca_size, gdfs->state.stack_capacity);
+						// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
+						memcpy((void *)&gdfs->state.stack[sizeof(Variant) * FIXED_ADDRESSES_MAX], (const void *)&stack[FIXED_ADDRESSES_MAX], sizeof(Variant) * (_stack_size - FIXED_ADDRESSES_MAX));
+					}
+					gdfs->state.alloca_size = alloca_size;
+					gdfs->state.stack_size = _stack_size;
+
 					awaited = true;
 
 #ifdef DEBUG_ENABLED
@@ -3882,6 +4321,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+#ifdef DEBUG_ENABLED
+				// Only costs a relaxed load while the sampling profiler is stopped.
+				GDScriptLanguage::check_sample_request();
+#endif
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3979,9 +4423,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	if (!p_state || awaited) {
 		GDScriptLanguage::get_singleton()->exit_function();
 
-		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		// Free stack, except reserved addresses. If awaited, it now belongs to the function state.
+		if (!awaited) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
 		}
 	}
 
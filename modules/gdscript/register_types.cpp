@@ -33,6 +33,7 @@
 #include "gdscript.h"
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
@@ -70,6 +71,9 @@ GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
+#ifdef DEBUG_ENABLED
+Ref<GDScriptSamplingProfiler> gdscript_sampling_profiler;
+#endif
 
 #ifdef TOOLS_ENABLED
 
@@ -152,6 +156,11 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+#ifdef DEBUG_ENABLED
+		gdscript_sampling_profiler.instantiate();
+		gdscript_sampling_profiler->bind("gdscript_sampler");
+#endif
 	}
 
 #ifdef TOOLS_ENABLED
@@ -168,6 +177,12 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
+#ifdef DEBUG_ENABLED
+		// Stops the sampling thread before the language goes away.
+		gdscript_sampling_profiler->unbind();
+		gdscript_sampling_profiler.unref();
+#endif
+
 		ScriptServer::unregister_language(script_language_gd);
 
 		if (gdscript_cache) {
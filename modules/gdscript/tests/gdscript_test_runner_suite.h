@@ -32,6 +32,9 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_jit.h"
+#include "../gdscript_sampling_profiler.h"
+
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -47,6 +50,22 @@ TEST_SUITE("[Modules][GDScript]") {
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+#ifdef GDSCRIPT_JIT_ENABLED
+	TEST_CASE("Script compilation and runtime with native code") {
+		// Translate functions on their first call, so the whole suite goes through the JIT wherever it can.
+		const uint32_t call_threshold = GDScriptJIT::get_call_threshold();
+		GDScriptJIT::set_call_threshold(0);
+		const uint32_t translated_before = GDScriptJIT::get_translated_function_count();
+		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames);
+		int fail_count = runner.run_tests();
+		GDScriptJIT::set_call_threshold(call_threshold);
+		INFO("Make sure `*.out` files have expected results.");
+		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should give the same results when run as native code.");
+		CHECK_MESSAGE(GDScriptJIT::get_translated_function_count() > translated_before, "Some functions of the suite should have been translated to native code.");
+	}
+#endif // GDSCRIPT_JIT_ENABLED
 }
 #endif // TOOLS_ENABLED
 
@@ -72,6 +91,51 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Bytecode optimizations can be turned off") {
+	const String source = R"(
+extends RefCounted
+
+var hp := 100
+
+func count(limit: int) -> int:
+	var i := 0
+	while i < limit:
+		i += 1
+	return i
+
+func hit(damage: int) -> int:
+	hp = hp - damage
+	return hp
+)";
+
+	int code_sizes[2][2] = {};
+	for (int pass = 0; pass < 2; pass++) {
+		const bool optimize = pass == 1;
+		GDScriptLanguage::get_singleton()->set_optimize_bytecode(optimize);
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The script should compile.");
+
+		code_sizes[pass][0] = gdscript->get_member_functions()[StringName("count")]->get_code_size();
+		code_sizes[pass][1] = gdscript->get_member_functions()[StringName("hit")]->get_code_size();
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		CHECK(int(ref_counted->call("count", 10)) == 10);
+		CHECK(int(ref_counted->call("hit", 30)) == 70);
+		CHECK(int(ref_counted->call("hit", 30)) == 40);
+	}
+
+	// The compare is fused with the jump and `i += 1` is folded into the assignment.
+	CHECK_MESSAGE(code_sizes[0][0] > code_sizes[1][0], "Unoptimized bytecode should keep the instructions separate.");
+	// `hp = hp - damage` writes straight into the member.
+	CHECK_MESSAGE(code_sizes[0][1] > code_sizes[1][1], "Unoptimized bytecode should assign the member from a temporary.");
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -102,4 +166,341 @@ TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	}
 }
 
+#ifdef DEBUG_ENABLED
+// Untyped, so the functions keep running in the VM, where samples are taken, even when the JIT is enabled.
+static const char *sampling_profiler_source = R"(
+extends RefCounted
+
+func hot_loop(count):
+	var total = 0
+	for i in count:
+		total += i % 7
+	return total
+
+func call_then_loop(callback, count):
+	callback.call()
+	return hot_loop(count)
+)";
+
+TEST_CASE("[Modules][GDScript] Sampling profiler records the running function") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(sampling_profiler_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	Ref<GDScriptSamplingProfiler> profiler;
+	profiler.instantiate();
+	profiler->toggle(true, Array());
+
+	// Keep the function running until the timer thread has requested a few samples.
+	HashMap<String, uint64_t> samples;
+	uint64_t hot_loop_samples = 0;
+	uint64_t other_samples = 0;
+	const uint64_t give_up_msec = OS::get_singleton()->get_ticks_msec() + 5000;
+	while (hot_loop_samples < 5 && OS::get_singleton()->get_ticks_msec() < give_up_msec) {
+		ref_counted->call("hot_loop", 10000);
+		GDScriptLanguage::get_singleton()->take_folded_samples(samples);
+		for (const KeyValue<String, uint64_t> &E : samples) {
+			if (E.key.contains(":hot_loop:")) {
+				hot_loop_samples += E.value;
+			} else {
+				other_samples += E.value;
+			}
+		}
+	}
+	profiler->toggle(false, Array());
+
+	CHECK_MESSAGE(hot_loop_samples >= 5, "The samples should be attributed to the function that was running.");
+	CHECK_MESSAGE(other_samples == 0, "No other call stack was running script code.");
+
+	// Once stopped, script code doesn't look at requests anymore.
+	GDScriptLanguage::get_singleton()->take_folded_samples(samples);
+	GDScriptLanguage::get_singleton()->request_sample();
+	ref_counted->call("hot_loop", 10000);
+	GDScriptLanguage::get_singleton()->take_folded_samples(samples);
+	CHECK_MESSAGE(samples.is_empty(), "No samples should be recorded while the profiler is stopped.");
+}
+
+// Called from script code: one request before the session starts, one after.
+static void _start_sampling_session() {
+	GDScriptLanguage::get_singleton()->request_sample();
+	GDScriptLanguage::get_singleton()->set_sampling_active(true);
+	GDScriptLanguage::get_singleton()->request_sample();
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler doesn't charge time spent outside of script code") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(sampling_profiler_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	// Requests are made by hand instead of by the timer thread, so the expected counts are exact.
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	HashMap<String, uint64_t> samples;
+	language->set_sampling_active(true);
+
+	// Made while this thread runs engine code between two calls, like the time between two frames.
+	for (int i = 0; i < 3; i++) {
+		language->request_sample();
+	}
+	ref_counted->call("hot_loop", 10);
+	language->take_folded_samples(samples);
+	CHECK_MESSAGE(samples.is_empty(), "Requests made while no script code ran on this thread should not be counted.");
+	language->set_sampling_active(false);
+
+	// The session starts while this thread is in the middle of a script call.
+	ref_counted->call("call_then_loop", callable_mp_static(&_start_sampling_session), 10);
+	language->take_folded_samples(samples);
+	uint64_t sample_count = 0;
+	for (const KeyValue<String, uint64_t> &E : samples) {
+		sample_count += E.value;
+	}
+	CHECK_MESSAGE(sample_count == 1, "Only the request made during the session should be counted.");
+	language->set_sampling_active(false);
+}
+#endif // DEBUG_ENABLED
+
+#if defined(GDSCRIPT_JIT_ENABLED) && defined(DEBUG_ENABLED)
+TEST_CASE("[Modules][GDScript] Functions stay in the VM while a profiler runs") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func add(a: int, b: int) -> int:
+	var sum := a + b
+	return sum
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	// Functions are only translated when they're about to run as native code, so the count tells where they ran.
+	const uint32_t call_threshold = GDScriptJIT::get_call_threshold();
+	GDScriptJIT::set_call_threshold(0);
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	const uint32_t translated_before = GDScriptJIT::get_translated_function_count();
+
+	language->profiling_start();
+	CHECK(int(ref_counted->call("add", 2, 3)) == 5);
+	language->profiling_stop();
+	CHECK_MESSAGE(GDScriptJIT::get_translated_function_count() == translated_before, "The function should run in the VM while the profiler runs.");
+
+	language->set_sampling_active(true);
+	CHECK(int(ref_counted->call("add", 2, 3)) == 5);
+	language->set_sampling_active(false);
+	CHECK_MESSAGE(GDScriptJIT::get_translated_function_count() == translated_before, "The function should run in the VM while the sampling profiler runs.");
+
+	CHECK(int(ref_counted->call("add", 2, 3)) == 5);
+	CHECK_MESSAGE(GDScriptJIT::get_translated_function_count() == translated_before + 1, "The function should run as native code once both profilers are stopped.");
+
+	GDScriptJIT::set_call_threshold(call_threshold);
+}
+#endif // GDSCRIPT_JIT_ENABLED && DEBUG_ENABLED
+
+// Runs each function of the script once with bytecode optimizations disabled, then enabled, and prints the timings.
+// Both passes must return the same values.
+static void _benchmark_bytecode_optimizations(const String &p_source, const Vector<StringName> &p_functions) {
+	Vector<Variant> unoptimized_results;
+	for (int pass = 0; pass < 2; pass++) {
+		const bool optimize = pass == 1;
+		GDScriptLanguage::get_singleton()->set_optimize_bytecode(optimize);
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(p_source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The benchmark script should compile.");
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		for (int i = 0; i < p_functions.size(); i++) {
+			const StringName &function = p_functions[i];
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			const Variant result = ref_counted->call(function);
+			const uint64_t end = OS::get_singleton()->get_ticks_usec();
+			print_line(vformat("%s (%s): %d usec", function, optimize ? "optimized" : "unoptimized", end - begin));
+
+			if (optimize) {
+				CHECK_MESSAGE(result == unoptimized_results[i], vformat("%s should return the same value with and without optimizations.", function));
+			} else {
+				unoptimized_results.push_back(result);
+			}
+		}
+	}
+}
+
+// Each loop leans on one of the merged sequences: a counted `while` loop, vector math assigned back
+// to typed locals, and an `if`/`elif` chain on float comparisons.
+TEST_CASE("[Modules][GDScript][Benchmark] Gameplay loops with and without bytecode optimizations" * doctest::skip()) {
+	const String source = R"(
+extends RefCounted
+
+var speed := 3.5
+
+func count_down() -> int:
+	var total := 0
+	var i := 0
+	while i < 1000000:
+		total += i & 7
+		i += 1
+	return total
+
+func integrate() -> Vector3:
+	var position := Vector3()
+	var velocity := Vector3(1, 2, 3)
+	var gravity := Vector3(0, -9.8, 0)
+	for _step in 500000:
+		velocity = velocity + gravity * 0.016
+		position = position + velocity * 0.016
+		if position.y < 0.0:
+			position.y = 0.0
+			velocity.y = -velocity.y * 0.5
+	return position
+
+func pick_targets() -> int:
+	var hits := 0
+	var distance := 0.0
+	for i in 1000000:
+		distance = float(i % 100) * speed
+		if distance < 50.0:
+			hits += 1
+		elif distance > 300.0:
+			hits -= 1
+	return hits
+)";
+
+	_benchmark_bytecode_optimizations(source, { "count_down", "integrate", "pick_targets" });
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Typed math with and without typed operators" * doctest::skip()) {
+	// Typed operators are part of the bytecode optimizations.
+	const String source = R"(
+extends RefCounted
+
+func noise_field() -> float:
+	var total := 0.0
+	var state := 12345
+	for y in 300:
+		for x in 300:
+			state = state * 1103515245 + 12345
+			var value := float(state & 1023) / 1023.0
+			var fx := float(x) * 0.05
+			var fy := float(y) * 0.05
+			total = total + value * fx - fy * 0.5
+	return total
+
+func steer() -> Vector3:
+	var position := Vector3()
+	var velocity := Vector3(1, 0, 0)
+	var target := Vector3(50, 10, -20)
+	var max_speed := 4.0
+	var delta := 0.016
+	for _step in 300000:
+		var desired := target - position
+		var steering := desired * 0.01 - velocity * 0.1
+		velocity = velocity + steering * delta
+		if velocity.length_squared() > max_speed * max_speed:
+			velocity = velocity * 0.9
+		position = position + velocity * delta
+	return position
+)";
+	_benchmark_bytecode_optimizations(source, { "noise_field", "steer" });
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Allocations per await with pooled coroutine frames" * doctest::skip()) {
+	const String source = R"(
+extends RefCounted
+
+signal tick
+
+func agent(frames):
+	var position := Vector3()
+	var velocity := Vector3(1, 0, 1)
+	for i in frames:
+		await tick
+		position += velocity
+
+func spawn(count, frames):
+	for i in count:
+		agent(frames)
+
+func step():
+	tick.emit()
+)";
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The benchmark script should compile.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	// Allocation counts are only tracked in debug builds. The first wave starts with an empty frame pool,
+	// the second one reuses the frames given back by the first. Resumed functions keep their frame.
+	const int agents = 1000;
+	const int frames = 10;
+	for (int wave = 0; wave < 2; wave++) {
+		uint64_t allocs = Memory::get_alloc_count();
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		ref_counted->call("spawn", agents, frames);
+		print_line(vformat("First await (wave %d): %.2f allocations, %.3f usec per await", wave, double(Memory::get_alloc_count() - allocs) / agents, double(OS::get_singleton()->get_ticks_usec() - begin) / agents));
+
+		allocs = Memory::get_alloc_count();
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < frames; i++) {
+			ref_counted->call("step");
+		}
+		print_line(vformat("Resume (wave %d): %.2f allocations, %.3f usec per resume", wave, double(Memory::get_alloc_count() - allocs) / (agents * frames), double(OS::get_singleton()->get_ticks_usec() - begin) / (agents * frames)));
+	}
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript][Benchmark] Line opcodes with the sampling profiler stopped and running" * doctest::skip()) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(sampling_profiler_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The benchmark script should compile.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	// The stopped timings are the cost the profiler adds to every debug build, compare them with a build without it.
+	Ref<GDScriptSamplingProfiler> profiler;
+	profiler.instantiate();
+	for (int pass = 0; pass < 2; pass++) {
+		const bool running = pass == 1;
+		if (running) {
+			profiler->toggle(true, Array());
+		}
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		ref_counted->call("hot_loop", 5000000);
+		const uint64_t end = OS::get_singleton()->get_ticks_usec();
+		if (running) {
+			profiler->toggle(false, Array());
+		}
+		print_line(vformat("hot_loop (sampling profiler %s): %d usec", running ? "running" : "stopped", end - begin));
+	}
+}
+#endif // DEBUG_ENABLED
+
 } // namespace GDScriptTests
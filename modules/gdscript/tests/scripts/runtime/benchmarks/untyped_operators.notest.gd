@@ -0,0 +1,73 @@
+# Benchmark for operators on untyped values, which go through the operator
+# type cache in the VM. Statically typed versions of the same loops use
+# validated operators directly and give the upper bound to compare against.
+#
+# Not run by the test suite, since timings are not deterministic. Run with:
+#     godot --headless --script modules/gdscript/tests/scripts/runtime/benchmarks/untyped_operators.notest.gd
+
+extends SceneTree
+
+const ITERATIONS = 2_000_000
+
+
+func untyped_int_loop():
+	var sum = 0
+	for i in ITERATIONS:
+		sum = sum + i * 3 - 1
+	return sum
+
+
+func typed_int_loop() -> int:
+	var sum := 0
+	for i: int in ITERATIONS:
+		sum = sum + i * 3 - 1
+	return sum
+
+
+# The first iteration adds an int to a float, every later one adds two floats,
+# so the `+=` site sees two type pairs.
+func untyped_mixed_loop():
+	var sum = 0
+	for i in ITERATIONS:
+		sum += i * 0.5
+	return sum
+
+
+func typed_mixed_loop() -> float:
+	var sum := 0.0
+	for i: int in ITERATIONS:
+		sum += i * 0.5
+	return sum
+
+
+func untyped_vector_loop():
+	var position = Vector3()
+	var velocity = Vector3(1, 2, 3)
+	for i in ITERATIONS:
+		position = position + velocity * 0.016
+	return position
+
+
+func typed_vector_loop() -> Vector3:
+	var position := Vector3()
+	var velocity := Vector3(1, 2, 3)
+	for i: int in ITERATIONS:
+		position = position + velocity * 0.016
+	return position
+
+
+func measure(label: String, callable: Callable) -> void:
+	var start := Time.get_ticks_usec()
+	callable.call()
+	var elapsed := Time.get_ticks_usec() - start
+	print("%-20s %8.2f ms" % [label, elapsed / 1000.0])
+
+
+func _init() -> void:
+	measure("untyped int", untyped_int_loop)
+	measure("typed int", typed_int_loop)
+	measure("untyped int/float", untyped_mixed_loop)
+	measure("typed float", typed_mixed_loop)
+	measure("untyped Vector3", untyped_vector_loop)
+	measure("typed Vector3", typed_vector_loop)
+	quit()
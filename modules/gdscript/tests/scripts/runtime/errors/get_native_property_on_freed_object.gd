@@ -0,0 +1,4 @@
+func test():
+	var node: Node2D = Node2D.new()
+	node.free()
+	print(node.position)
@@ -0,0 +1,4 @@
+func test():
+	var node: Node2D = Node2D.new()
+	node.free()
+	node.position = Vector2(1, 2)
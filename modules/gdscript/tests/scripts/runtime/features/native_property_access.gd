@@ -0,0 +1,41 @@
+# Engine properties of statically typed objects call their native accessors directly,
+# and must behave like `Object.get()` and `Object.set()`, including on scripted objects.
+
+class Mover extends Node2D:
+	func step() -> void:
+		position = Vector2(1, 2)
+		position.x += 3.0
+		rotation += 0.5
+
+class Intercepted extends Node2D:
+	func _set(property: StringName, value: Variant) -> bool:
+		if property == &"position":
+			print("_set(%s)" % value)
+			return true
+		return false
+
+	func _get(property: StringName) -> Variant:
+		if property == &"position":
+			return Vector2(-1, -1)
+		return null
+
+func test():
+	var plain: Node2D = Node2D.new()
+	plain.position = Vector2(5, 6)
+	plain.position.y += 1.0
+	plain.visible = false
+	print(plain.position)
+	print(plain.visible)
+
+	var mover := Mover.new()
+	mover.step()
+	print(mover.position)
+	print(mover.rotation)
+
+	var intercepted: Node2D = Intercepted.new()
+	intercepted.position = Vector2(7, 8)
+	print(intercepted.position)
+
+	plain.free()
+	mover.free()
+	intercepted.free()
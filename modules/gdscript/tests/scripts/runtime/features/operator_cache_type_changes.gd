@@ -0,0 +1,28 @@
+# Untyped operator sites cache the operand types they see. Check that results
+# stay correct when the types change between runs of the same site.
+
+func add(a, b):
+	return a + b
+
+func eq(a, b):
+	return a == b
+
+func test():
+	var sum = 0
+	for i in 4:
+		sum += i * 0.5
+	print(sum)
+
+	print(add(1, 2))
+	print(add(1.5, 2))
+	print(add("a", "b"))
+	print(add(Vector2(1, 2), Vector2(3, 4)))
+	print(add(1, 2))
+	print(add([1], [2]))
+	print(add(1.5, 2))
+
+	# `null` with `null` has the same signature as an empty cache entry.
+	print(eq(1, 1))
+	print(eq(null, null))
+	print(eq(null, null))
+	print(eq(1, 2))
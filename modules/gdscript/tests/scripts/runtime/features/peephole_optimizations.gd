@@ -0,0 +1,72 @@
+# Operations folded into assignments and comparisons fused with jumps must behave as before.
+
+var speed := 4.0
+var hp := 100
+
+func sum_below(limit: int) -> int:
+	var total := 0
+	var i := 0
+	while i < limit:
+		total += i
+		i += 1
+	return total
+
+func classify(value: float) -> String:
+	if value < 0.0:
+		return "negative"
+	elif value == 0.0:
+		return "zero"
+	elif value > 100.0:
+		return "large"
+	return "positive"
+
+func test():
+	print(sum_below(10))
+	print(classify(-1.5), " ", classify(0.0), " ", classify(3.0), " ", classify(1000.0))
+
+	# The result of the operation has to land in the local that is assigned, even when it is an operand.
+	var position := Vector2(1, 2)
+	var velocity := Vector2(0.5, -1)
+	for _step in 4:
+		position = position + velocity * 2.0
+	print(position)
+
+	# Int operands assigned to a float local still convert.
+	var f: float = 1.5
+	f = f + 1
+	var n := 7
+	f = n * 2
+	print(f)
+
+	# Stack slots reused by locals of a different type in sibling blocks.
+	if n > 0:
+		var s := "text"
+		s = s + "!"
+		print(s)
+	if n > 1:
+		var k: int
+		k = n + 1
+		k = k * k
+		print(k)
+
+	# Ternaries jump right before the assignment.
+	var picked := 0
+	picked = n + 1 if n > 100 else n - 1
+	print(picked)
+
+	# Arrays are shared, so `a = a + b` must still produce a new array.
+	var original := [1, 2]
+	var alias := original
+	alias = alias + [3]
+	print(original, " ", alias)
+
+	var flag := false
+	flag = n > 3 and n < 10
+	print(flag)
+
+	# Typed members are written in place too.
+	for _step in 3:
+		speed = speed * 0.5
+	hp -= 25
+	hp = hp + n
+	print(speed, " ", hp)
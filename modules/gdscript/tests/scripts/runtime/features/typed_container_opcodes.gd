@@ -0,0 +1,30 @@
+# Indexing statically typed arrays and dictionaries skips the container type checks, and must behave like the generic path.
+
+func test():
+	var ints: Array[int] = [1, 2, 3]
+	ints[0] = 10
+	ints[-1] = ints[1] * 2
+	print(ints)
+	print(ints[-3])
+
+	var floats: Array[float] = [0.5, 1.5]
+	floats[1] = floats[0] + 0.25
+	# Int values are converted to float by the generic path.
+	floats[0] = 2
+	print(floats)
+	print(typeof(floats[0]) == TYPE_FLOAT)
+
+	var names: Dictionary[String, int] = { "a": 1 }
+	names["b"] = names["a"] + 1
+	names["a"] = 5
+	print(names)
+	print(names["b"])
+
+	var vectors: Dictionary[int, Vector3] = {}
+	vectors[3] = Vector3(1, 2, 3)
+	print(vectors[3])
+
+	var total := 0
+	for i in ints.size():
+		total += ints[i]
+	print(total)
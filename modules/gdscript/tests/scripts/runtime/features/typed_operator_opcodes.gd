@@ -0,0 +1,50 @@
+# Operators on statically typed int, float and Vector3 values are evaluated inline and must match the generic path.
+
+var member_total: int = 0
+
+func int_ops(a: int, b: int) -> Array:
+	return [a + b, a - b, a * b, a == b, a < b, a > b]
+
+func float_ops(a: float, b: float) -> Array:
+	return [a + b, a - b, a * b, a / b, a < b, a > b]
+
+func vector_ops(a: Vector3, b: Vector3, s: float) -> Array:
+	return [a + b, a - b, a * s]
+
+func test():
+	print(int_ops(7, 3))
+	print(int_ops(-4, -4))
+
+	print(float_ops(1.5, 0.5))
+	print(float_ops(-2.0, 4.0))
+	print(float_ops(1.0, 0.0)[3])
+
+	print(vector_ops(Vector3(1, 2, 3), Vector3(0.5, -1, 2), 2.0))
+
+	# Untyped operands still go through the generic path and give the same results.
+	var x = 7
+	var y = 3
+	print([x + y, x - y, x * y, x == y, x < y, x > y])
+
+	# Results are stored into typed locals, including when they are also operands.
+	var total := 0
+	var scale := 1.0
+	var offset := Vector3.ZERO
+	for i in 4:
+		total = total * 2 + i
+		scale = scale * 1.5 - 0.25
+		offset = offset + Vector3(i, -i, 0.5) * scale
+	print(total, " ", scale)
+	print(offset)
+
+	# Comparisons used as conditions are fused with the jump, and results can be stored straight into members.
+	var count := 0
+	var value := 0.0
+	while value < 2.0:
+		value = value + 0.5
+		count = count + 1
+	print(count, " ", value)
+	for i in 5:
+		if i > 2:
+			member_total = member_total + i
+	print(member_total)
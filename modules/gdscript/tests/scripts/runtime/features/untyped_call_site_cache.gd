@@ -0,0 +1,36 @@
+# The same untyped call site has to keep dispatching correctly when the receiver type changes.
+
+class A:
+	func describe():
+		return "A"
+
+class B extends A:
+	func describe():
+		return "B extends " + super()
+
+class C extends A:
+	pass
+
+class D:
+	func describe():
+		return "D"
+
+class E extends RefCounted:
+	pass
+
+func call_describe(value):
+	return value.describe()
+
+func call_get_class(value):
+	return value.get_class()
+
+func test():
+	var receivers = [A.new(), B.new(), C.new(), D.new(), A.new(), D.new(), B.new()]
+	for i in 2:
+		for receiver in receivers:
+			print(call_describe(receiver))
+
+	var objects = [RefCounted.new(), E.new(), Resource.new(), Object.new(), E.new(), RefCounted.new()]
+	for object in objects:
+		print(call_get_class(object))
+	objects[3].free()
@@ -313,6 +313,11 @@ void test(TestType p_type) {
 	// Initialize the language for the test routine.
 	init_language(fa->get_path_absolute().get_base_dir());
 
+	// Pass `--gdscript-unoptimized` to see the bytecode as emitted, before instructions get merged.
+	if (p_type == TEST_COMPILER && cmdlargs.find("--gdscript-unoptimized")) {
+		GDScriptLanguage::get_singleton()->set_optimize_bytecode(false);
+	}
+
 	// Load global classes.
 	TypedArray<Dictionary> script_classes = ProjectSettings::get_singleton()->get_global_class_list();
 	for (int i = 0; i < script_classes.size(); i++) {
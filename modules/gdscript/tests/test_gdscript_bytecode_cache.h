@@ -0,0 +1,243 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode_cache.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "tests/core/config/test_project_settings.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+static const char *bytecode_cache_main_source = R"(
+extends RefCounted
+
+const Dep = preload("dep.gd")
+
+class Counter:
+	var total := 0
+
+	func add(p_value: int) -> void:
+		total += p_value
+
+var label := "sum"
+
+func run() -> Array:
+	var counter := Counter.new()
+	for value in Dep.scale([1, 2, 3]):
+		counter.add(value)
+	var squares := {}
+	for i in 4:
+		squares[i] = i * i
+	return [label, counter.total, squares, Vector2(1.5, 2.0).length_squared(), "%s=%d" % [label, counter.total]]
+)";
+
+static const char *bytecode_cache_dep_source = R"(
+const FACTOR = 3
+
+static func scale(p_values: Array[int]) -> Array[int]:
+	var result: Array[int] = []
+	for value in p_values:
+		result.push_back(value * FACTOR)
+	return result
+)";
+
+static void _write_bytecode_cache_file(const String &p_path, const Vector<uint8_t> &p_data) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_buffer(p_data);
+}
+
+static void _write_bytecode_cache_script(const String &p_path, const String &p_source) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_source);
+}
+
+// A script object that isn't in `GDScriptCache` yet, like `GDScriptCache::get_shallow_script()` starts with.
+static Ref<GDScript> _make_bytecode_cache_script(const String &p_path) {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_path(p_path, true);
+	REQUIRE(script->load_source_code(p_path) == OK);
+	return script;
+}
+
+static Array _run_bytecode_cache_script(const Ref<GDScript> &p_script) {
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(p_script);
+	return ref_counted->call("run");
+}
+
+// Compiles `main.gd` and `dep.gd` in their own folder of a temporary project, which writes their cache files.
+// Each test uses its own folder, since scripts stay in `GDScriptCache` for the rest of the run.
+struct BytecodeCacheProject {
+	String old_resource_path;
+	String main_path;
+	String dep_path;
+	String cache_path;
+	Ref<GDScript> compiled;
+
+	BytecodeCacheProject(const String &p_folder) {
+		const String project_dir = TestUtils::get_temp_path("gdscript_bytecode_cache");
+		old_resource_path = TestProjectSettingsInternalsAccessor::resource_path();
+		TestProjectSettingsInternalsAccessor::resource_path() = project_dir;
+		GDScriptLanguage::get_singleton()->set_bytecode_cache_enabled(true);
+		GDScriptBytecodeCache::clear();
+
+		main_path = "res://" + p_folder + "/main.gd";
+		dep_path = "res://" + p_folder + "/dep.gd";
+		cache_path = GDScriptBytecodeCache::get_cache_path(main_path);
+		DirAccess::make_dir_recursive_absolute(main_path.get_base_dir());
+		_write_bytecode_cache_script(main_path, bytecode_cache_main_source);
+		_write_bytecode_cache_script(dep_path, bytecode_cache_dep_source);
+		// Left over from an earlier run of the tests.
+		if (FileAccess::exists(cache_path)) {
+			DirAccess::remove_absolute(cache_path);
+		}
+
+		Error err = OK;
+		compiled = GDScriptCache::get_full_script(main_path, err);
+		REQUIRE(err == OK);
+		REQUIRE(compiled.is_valid());
+		REQUIRE(FileAccess::exists(cache_path));
+	}
+
+	~BytecodeCacheProject() {
+		GDScriptLanguage::get_singleton()->set_bytecode_cache_enabled(false);
+		GDScriptBytecodeCache::clear();
+		TestProjectSettingsInternalsAccessor::resource_path() = old_resource_path;
+	}
+};
+
+TEST_CASE("[Modules][GDScript] Scripts loaded from the bytecode cache run the same code") {
+	BytecodeCacheProject project("round_trip");
+	const Array expected = _run_bytecode_cache_script(project.compiled);
+	REQUIRE(expected.size() == 5);
+	CHECK(expected[1] == Variant(18));
+
+	Ref<GDScript> cached = _make_bytecode_cache_script(project.main_path);
+	Vector<uint8_t> payload = GDScriptBytecodeCache::read(cached.ptr());
+	REQUIRE_FALSE(payload.is_empty());
+	REQUIRE(GDScriptBytecodeCache::make_scripts(cached.ptr(), payload) == OK);
+
+	// Compiling from source writes the cache file again, so it staying gone shows `reload()` didn't fall back to that.
+	DirAccess::remove_absolute(project.cache_path);
+	CHECK(cached->reload() == OK);
+	CHECK_FALSE(FileAccess::exists(project.cache_path));
+	CHECK(_run_bytecode_cache_script(cached) == expected);
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache files are ignored once the build key, the source or a dependency changes") {
+	BytecodeCacheProject project("stale");
+	Ref<GDScript> script = _make_bytecode_cache_script(project.main_path);
+	REQUIRE_FALSE(GDScriptBytecodeCache::read(script.ptr()).is_empty());
+
+	// An empty payload makes `GDScriptCache::get_shallow_script()` parse and compile the source instead.
+	Ref<GDScript> edited = _make_bytecode_cache_script(project.main_path);
+	edited->set_source_code(edited->get_source_code().replace(R"("sum")", R"("total")"));
+	CHECK(GDScriptBytecodeCache::read(edited.ptr()).is_empty());
+
+	// Dependency hashes and the build key are only computed once per run, the same cache clear happens on startup.
+	_write_bytecode_cache_script(project.dep_path, String(bytecode_cache_dep_source).replace("FACTOR = 3", "FACTOR = 4"));
+	GDScriptBytecodeCache::clear();
+	CHECK(GDScriptBytecodeCache::read(script.ptr()).is_empty());
+	_write_bytecode_cache_script(project.dep_path, bytecode_cache_dep_source);
+	GDScriptBytecodeCache::clear();
+	CHECK_FALSE(GDScriptBytecodeCache::read(script.ptr()).is_empty());
+
+	// A new global class changes what identifiers resolve to, so it's part of the build key.
+	ScriptServer::add_global_class("BytecodeCacheTestClass", "RefCounted", "GDScript", "res://stale/unused.gd", false, false);
+	GDScriptBytecodeCache::clear();
+	CHECK(GDScriptBytecodeCache::read(script.ptr()).is_empty());
+	ScriptServer::remove_global_class("BytecodeCacheTestClass");
+	GDScriptBytecodeCache::clear();
+	CHECK_FALSE(GDScriptBytecodeCache::read(script.ptr()).is_empty());
+
+	// Files written with bytecode optimizations must not be loaded with them turned off, and the other way around.
+	GDScriptLanguage::get_singleton()->set_optimize_bytecode(false);
+	GDScriptBytecodeCache::clear();
+	CHECK(GDScriptBytecodeCache::read(script.ptr()).is_empty());
+	GDScriptLanguage::get_singleton()->set_optimize_bytecode(true);
+	GDScriptBytecodeCache::clear();
+	CHECK_FALSE(GDScriptBytecodeCache::read(script.ptr()).is_empty());
+}
+
+TEST_CASE("[Modules][GDScript] Truncated and corrupt bytecode cache files are rejected") {
+	BytecodeCacheProject project("corrupt");
+	Ref<GDScript> script = _make_bytecode_cache_script(project.main_path);
+	const Vector<uint8_t> file = FileAccess::get_file_as_bytes(project.cache_path);
+	const Vector<uint8_t> payload = GDScriptBytecodeCache::read(script.ptr());
+	REQUIRE_FALSE(payload.is_empty());
+
+	int accepted_truncated_files = 0;
+	for (int64_t length = 0; length < file.size(); length++) {
+		_write_bytecode_cache_file(project.cache_path, file.slice(0, length));
+		if (!GDScriptBytecodeCache::read(script.ptr()).is_empty()) {
+			accepted_truncated_files++;
+		}
+	}
+	CHECK(accepted_truncated_files == 0);
+
+	// Every byte is covered by the header checks, a dependency hash or the payload hash.
+	int accepted_corrupt_files = 0;
+	for (int64_t i = 0; i < file.size(); i++) {
+		Vector<uint8_t> corrupt = file;
+		corrupt.write[i] ^= 0xFF;
+		_write_bytecode_cache_file(project.cache_path, corrupt);
+		if (!GDScriptBytecodeCache::read(script.ptr()).is_empty()) {
+			accepted_corrupt_files++;
+		}
+	}
+	CHECK(accepted_corrupt_files == 0);
+
+	_write_bytecode_cache_file(project.cache_path, file);
+	CHECK(GDScriptBytecodeCache::read(script.ptr()) == payload);
+
+	// Past the hash check, the payload is still read with bounds checks, so a short one fails to load instead of crashing.
+	int accepted_truncated_payloads = 0;
+	for (int64_t length = 0; length < payload.size(); length++) {
+		Ref<GDScript> truncated;
+		truncated.instantiate();
+		const Vector<uint8_t> truncated_payload = payload.slice(0, length);
+		if (GDScriptBytecodeCache::make_scripts(truncated.ptr(), truncated_payload) == OK && GDScriptBytecodeCache::load(truncated.ptr(), truncated_payload) == OK) {
+			accepted_truncated_payloads++;
+		}
+	}
+	CHECK(accepted_truncated_payloads == 0);
+}
+
+} // namespace GDScriptTests
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  test_gdscript_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+// `main.gd` depends on scripts through `preload()` and `extends`, and two of them preload each other.
+static void _write_dependency_scripts(const String &p_dir) {
+	static const char *sources[][2] = {
+		{ "main.gd", R"(
+extends RefCounted
+
+const A = preload("a.gd")
+const C = preload("c.gd")
+
+func run() -> Array:
+	return [A.NAME, A.B.NAME, A.describe(), A.B.describe(), C.new().value()]
+)" },
+		{ "a.gd", R"(
+const B = preload("b.gd")
+const NAME = "a"
+
+static func describe() -> String:
+	return NAME + B.NAME
+)" },
+		{ "b.gd", R"(
+const A = preload("a.gd")
+const NAME = "b"
+
+static func describe() -> String:
+	return NAME + A.NAME
+)" },
+		{ "c.gd", R"(
+extends "base.gd"
+
+func value() -> int:
+	return base_value() * 2
+)" },
+		{ "base.gd", R"(
+extends RefCounted
+
+func base_value() -> int:
+	return 21
+)" },
+	};
+
+	DirAccess::make_dir_recursive_absolute(p_dir);
+	for (const auto &source : sources) {
+		Ref<FileAccess> f = FileAccess::open(p_dir.path_join(source[0]), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(source[1]);
+	}
+}
+
+static Array _run_main_script(const Ref<GDScript> &p_script) {
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(p_script);
+	return ref_counted->call("run");
+}
+
+struct DependencyScriptLoad {
+	String path;
+	Ref<GDScript> script;
+	Error error = OK;
+};
+
+static void _load_dependency_script(void *p_userdata) {
+	DependencyScriptLoad *load = static_cast<DependencyScriptLoad *>(p_userdata);
+	load->script = GDScriptCache::get_full_script(load->path, load->error);
+}
+
+TEST_CASE("[Modules][GDScript] Dependencies parsed on the worker thread pool give the same scripts from any thread") {
+	// Both ways must also finish with a single pool thread, including when that thread is the one loading the script.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(1);
+
+	// Same scripts in two folders, so the second load doesn't find the first one's parsers in the cache.
+	const String main_thread_dir = TestUtils::get_temp_path("gdscript_dependencies/main_thread");
+	const String pool_thread_dir = TestUtils::get_temp_path("gdscript_dependencies/pool_thread");
+	_write_dependency_scripts(main_thread_dir);
+	_write_dependency_scripts(pool_thread_dir);
+
+	// From this thread, each wave of dependencies is handed to the pool as a group.
+	Error error = OK;
+	Ref<GDScript> main_thread_script = GDScriptCache::get_full_script(main_thread_dir.path_join("main.gd"), error);
+	CHECK(error == OK);
+
+	// From a pool thread, like threaded resource loads, each dependency gets its own task.
+	DependencyScriptLoad pool_thread_load;
+	pool_thread_load.path = pool_thread_dir.path_join("main.gd");
+	WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(&_load_dependency_script, &pool_thread_load);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	CHECK(pool_thread_load.error == OK);
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+
+	REQUIRE(main_thread_script.is_valid());
+	REQUIRE(pool_thread_load.script.is_valid());
+	const Array expected = { "a", "b", "ab", "ba", 42 };
+	CHECK(_run_main_script(main_thread_script) == expected);
+	CHECK(_run_main_script(pool_thread_load.script) == expected);
+}
+
+} // namespace GDScriptTests
@@ -31,6 +31,15 @@
 #include "godot_area_pair_2d.h"
 #include "godot_collision_solver_2d.h"
 
+GodotConstraint2D::SortKey GodotAreaPair2D::get_sort_key() const {
+	SortKey key;
+	key.id_a = body->get_self().get_id();
+	key.id_b = area->get_self().get_id();
+	key.subindex_a = body_shape;
+	key.subindex_b = area_shape;
+	return key;
+}
+
 bool GodotAreaPair2D::setup(real_t p_step) {
 	bool result = false;
 	if (area->collides_with(body) && GodotCollisionSolver2D::solve(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), Vector2(), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), Vector2(), nullptr, this)) {
@@ -119,6 +128,15 @@ GodotAreaPair2D::~GodotAreaPair2D() {
 
 //////////////////////////////////
 
+GodotConstraint2D::SortKey GodotArea2Pair2D::get_sort_key() const {
+	SortKey key;
+	key.id_a = area_a->get_self().get_id();
+	key.id_b = area_b->get_self().get_id();
+	key.subindex_a = shape_a;
+	key.subindex_b = shape_b;
+	return key;
+}
+
 bool GodotArea2Pair2D::setup(real_t p_step) {
 	bool result_a = area_a->collides_with(area_b);
 	bool result_b = area_b->collides_with(area_a);
@@ -149,6 +149,64 @@ void GodotBody2D::set_active(bool p_active) {
 	}
 }
 
+void GodotBody2D::save_state(GodotSnapshotWriter2D &p_writer) const {
+	p_writer.put(get_transform());
+	p_writer.put(get_inv_transform());
+	p_writer.put(new_transform);
+	p_writer.put(linear_velocity);
+	p_writer.put(angular_velocity);
+	p_writer.put(prev_linear_velocity);
+	p_writer.put(prev_angular_velocity);
+	p_writer.put(biased_linear_velocity);
+	p_writer.put(biased_angular_velocity);
+	p_writer.put(applied_force);
+	p_writer.put(applied_torque);
+	p_writer.put(constant_force);
+	p_writer.put(constant_torque);
+	p_writer.put(still_time);
+	p_writer.put<uint8_t>(active);
+}
+
+bool GodotBody2D::read_state(GodotSnapshotReader2D &p_reader, SavedState &r_state) {
+	r_state.transform = p_reader.get<Transform2D>();
+	r_state.inv_transform = p_reader.get<Transform2D>();
+	r_state.new_transform = p_reader.get<Transform2D>();
+	r_state.linear_velocity = p_reader.get<Vector2>();
+	r_state.angular_velocity = p_reader.get<real_t>();
+	r_state.prev_linear_velocity = p_reader.get<Vector2>();
+	r_state.prev_angular_velocity = p_reader.get<real_t>();
+	r_state.biased_linear_velocity = p_reader.get<Vector2>();
+	r_state.biased_angular_velocity = p_reader.get<real_t>();
+	r_state.applied_force = p_reader.get<Vector2>();
+	r_state.applied_torque = p_reader.get<real_t>();
+	r_state.constant_force = p_reader.get<Vector2>();
+	r_state.constant_torque = p_reader.get<real_t>();
+	r_state.still_time = p_reader.get<real_t>();
+	r_state.active = p_reader.get<uint8_t>();
+	return !p_reader.failed;
+}
+
+void GodotBody2D::apply_state(const SavedState &p_state) {
+	// Both transforms are restored as saved, recomputing the inverse could differ in the last bits.
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+	new_transform = p_state.new_transform;
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	biased_linear_velocity = p_state.biased_linear_velocity;
+	biased_angular_velocity = p_state.biased_angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	constant_force = p_state.constant_force;
+	constant_torque = p_state.constant_torque;
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+}
+
 void GodotBody2D::set_param(PhysicsServer2D::BodyParameter p_param, const Variant &p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::BODY_PARAM_BOUNCE: {
@@ -34,12 +34,51 @@
 #include "godot_collision_object_2d.h"
 
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/vset.h"
 
 class GodotConstraint2D;
 class GodotPhysicsDirectBodyState2D;
 
+// Plain value streams for space state snapshots, see GodotSpace2D::save_state().
+// Snapshots are only meant to be restored by the process that saved them, so
+// values are stored in their native layout.
+struct GodotSnapshotWriter2D {
+	LocalVector<uint8_t> data;
+
+	template <typename T>
+	_FORCE_INLINE_ void put(const T &p_value) {
+		uint32_t ofs = data.size();
+		data.resize(ofs + sizeof(T));
+		memcpy(&data[ofs], &p_value, sizeof(T));
+	}
+};
+
+struct GodotSnapshotReader2D {
+	const uint8_t *ptr = nullptr;
+	const uint8_t *end = nullptr;
+	bool failed = false;
+
+	// Reading past the end sets `failed` and returns zeroed values.
+	template <typename T>
+	_FORCE_INLINE_ T get() {
+		T value = T();
+		if (failed || size_t(end - ptr) < sizeof(T)) {
+			failed = true;
+			return value;
+		}
+		memcpy(&value, ptr, sizeof(T));
+		ptr += sizeof(T);
+		return value;
+	}
+
+	GodotSnapshotReader2D(const uint8_t *p_ptr, size_t p_size) {
+		ptr = p_ptr;
+		end = p_ptr + p_size;
+	}
+};
+
 class GodotBody2D : public GodotCollisionObject2D {
 	PhysicsServer2D::BodyMode mode = PhysicsServer2D::BODY_MODE_RIGID;
 
@@ -284,6 +323,30 @@ public:
 	void set_active(bool p_active);
 	_FORCE_INLINE_ bool is_active() const { return active; }
 
+	// Transform, velocities, forces and sleep state, for rollback.
+	// Reading is separate from applying, so a whole snapshot can be validated first.
+	struct SavedState {
+		Transform2D transform;
+		Transform2D inv_transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 prev_linear_velocity;
+		real_t prev_angular_velocity = 0.0;
+		Vector2 biased_linear_velocity;
+		real_t biased_angular_velocity = 0.0;
+		Vector2 applied_force;
+		real_t applied_torque = 0.0;
+		Vector2 constant_force;
+		real_t constant_torque = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_state(GodotSnapshotWriter2D &p_writer) const;
+	static bool read_state(GodotSnapshotReader2D &p_reader, SavedState &r_state);
+	void apply_state(const SavedState &p_state);
+
 	_FORCE_INLINE_ void wakeup() {
 		if ((!get_space()) || mode == PhysicsServer2D::BODY_MODE_STATIC || mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 			return;
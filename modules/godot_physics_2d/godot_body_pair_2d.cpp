@@ -593,6 +593,97 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint2D::SortKey GodotBodyPair2D::get_sort_key() const {
+	SortKey key;
+	key.id_a = A->get_self().get_id();
+	key.id_b = B->get_self().get_id();
+	key.subindex_a = shape_A;
+	key.subindex_b = shape_B;
+	return key;
+}
+
+void GodotBodyPair2D::save_state(GodotSnapshotWriter2D &p_writer) const {
+	p_writer.put(sep_axis);
+	p_writer.put<uint8_t>(collided);
+	p_writer.put<uint8_t>(oneway_disabled);
+	p_writer.put<uint8_t>(contact_count);
+
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		p_writer.put(c.position);
+		p_writer.put(c.normal);
+		p_writer.put(c.local_A);
+		p_writer.put(c.local_B);
+		p_writer.put(c.acc_impulse);
+		p_writer.put(c.acc_normal_impulse);
+		p_writer.put(c.acc_tangent_impulse);
+		p_writer.put(c.acc_bias_impulse);
+		p_writer.put(c.acc_bias_impulse_center_of_mass);
+		p_writer.put(c.mass_normal);
+		p_writer.put(c.mass_tangent);
+		p_writer.put(c.bias);
+		p_writer.put(c.depth);
+		p_writer.put<uint8_t>(c.active);
+		p_writer.put<uint8_t>(c.used);
+		p_writer.put(c.rA);
+		p_writer.put(c.rB);
+		p_writer.put(c.bounce);
+	}
+}
+
+bool GodotBodyPair2D::read_state(GodotSnapshotReader2D &p_reader, SavedState &r_state) {
+	r_state.sep_axis = p_reader.get<Vector2>();
+	r_state.collided = p_reader.get<uint8_t>();
+	r_state.oneway_disabled = p_reader.get<uint8_t>();
+	r_state.contact_count = p_reader.get<uint8_t>();
+
+	if (r_state.contact_count > MAX_CONTACTS) {
+		return false;
+	}
+
+	for (int i = 0; i < r_state.contact_count; i++) {
+		Contact &c = r_state.contacts[i];
+		c.position = p_reader.get<Vector2>();
+		c.normal = p_reader.get<Vector2>();
+		c.local_A = p_reader.get<Vector2>();
+		c.local_B = p_reader.get<Vector2>();
+		c.acc_impulse = p_reader.get<Vector2>();
+		c.acc_normal_impulse = p_reader.get<real_t>();
+		c.acc_tangent_impulse = p_reader.get<real_t>();
+		c.acc_bias_impulse = p_reader.get<real_t>();
+		c.acc_bias_impulse_center_of_mass = p_reader.get<real_t>();
+		c.mass_normal = p_reader.get<real_t>();
+		c.mass_tangent = p_reader.get<real_t>();
+		c.bias = p_reader.get<real_t>();
+		c.depth = p_reader.get<real_t>();
+		c.active = p_reader.get<uint8_t>();
+		c.used = p_reader.get<uint8_t>();
+		c.rA = p_reader.get<Vector2>();
+		c.rB = p_reader.get<Vector2>();
+		c.bounce = p_reader.get<real_t>();
+	}
+
+	return !p_reader.failed;
+}
+
+void GodotBodyPair2D::apply_state(const SavedState &p_state) {
+	sep_axis = p_state.sep_axis;
+	collided = p_state.collided;
+	oneway_disabled = p_state.oneway_disabled;
+	contact_count = p_state.contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_state.contacts[i];
+	}
+}
+
+void GodotBodyPair2D::reset_state() {
+	// Same as a newly created pair.
+	sep_axis = Vector2();
+	collided = false;
+	oneway_disabled = false;
+	contact_count = 0;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
 		GodotConstraint2D(_arr, 2) {
 	A = p_A;
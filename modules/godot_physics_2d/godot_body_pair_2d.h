@@ -63,7 +63,7 @@ class GodotBodyPair2D : public GodotConstraint2D {
 		real_t acc_tangent_impulse = 0.0; // accumulated tangent impulse (Pt)
 		real_t acc_bias_impulse = 0.0; // accumulated normal impulse for position bias (Pnb)
 		real_t acc_bias_impulse_center_of_mass = 0.0; // accumulated normal impulse for position bias applied to com
-		real_t mass_normal, mass_tangent = 0.0;
+		real_t mass_normal = 0.0, mass_tangent = 0.0;
 		real_t bias = 0.0;
 
 		real_t depth = 0.0;
@@ -89,6 +89,24 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	virtual SortKey get_sort_key() const override;
+	virtual bool is_body_pair() const override { return true; }
+
+	// Contacts and collision state carried between steps, for rollback.
+	// Reading is separate from applying, so a whole snapshot can be validated first.
+	struct SavedState {
+		Vector2 sep_axis;
+		bool collided = false;
+		bool oneway_disabled = false;
+		int contact_count = 0;
+		Contact contacts[MAX_CONTACTS];
+	};
+
+	void save_state(GodotSnapshotWriter2D &p_writer) const;
+	static bool read_state(GodotSnapshotReader2D &p_reader, SavedState &r_state);
+	void apply_state(const SavedState &p_state);
+	void reset_state();
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
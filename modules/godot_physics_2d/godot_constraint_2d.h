@@ -32,7 +32,46 @@
 
 #include "godot_body_2d.h"
 
+#include "core/templates/hashfuncs.h"
+
 class GodotConstraint2D {
+public:
+	// Orders constraints independently of their creation order and address,
+	// for deterministic spaces. RIDs are allocated sequentially, so the same
+	// sequence of server calls gives the same order on every run.
+	struct SortKey {
+		uint64_t id_a = 0;
+		uint64_t id_b = 0;
+		int32_t subindex_a = 0;
+		int32_t subindex_b = 0;
+
+		_FORCE_INLINE_ bool operator==(const SortKey &p_key) const {
+			return id_a == p_key.id_a && id_b == p_key.id_b && subindex_a == p_key.subindex_a && subindex_b == p_key.subindex_b;
+		}
+
+		_FORCE_INLINE_ bool operator<(const SortKey &p_key) const {
+			if (id_a != p_key.id_a) {
+				return id_a < p_key.id_a;
+			}
+			if (id_b != p_key.id_b) {
+				return id_b < p_key.id_b;
+			}
+			if (subindex_a != p_key.subindex_a) {
+				return subindex_a < p_key.subindex_a;
+			}
+			return subindex_b < p_key.subindex_b;
+		}
+
+		static _FORCE_INLINE_ uint32_t hash(const SortKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.id_a);
+			h = hash_murmur3_one_64(p_key.id_b, h);
+			h = hash_murmur3_one_32(p_key.subindex_a, h);
+			h = hash_murmur3_one_32(p_key.subindex_b, h);
+			return hash_fmix32(h);
+		}
+	};
+
+private:
 	GodotBody2D **_body_ptr;
 	int _body_count;
 	uint64_t island_step = 0;
@@ -59,6 +98,15 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Pairs don't have a RID, they override this with the RIDs of their objects.
+	virtual SortKey get_sort_key() const {
+		SortKey key;
+		key.id_a = self.get_id();
+		return key;
+	}
+
+	virtual bool is_body_pair() const { return false; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
@@ -1011,15 +1011,25 @@ bool GodotSpace2D::test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::
 
 // Assumes a valid collision pair, this should have been checked beforehand in the BVH or octree.
 void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self) {
+	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
+
 	GodotCollisionObject2D::Type type_A = A->get_type();
 	GodotCollisionObject2D::Type type_B = B->get_type();
 	if (type_A > type_B) {
 		SWAP(A, B);
 		SWAP(p_subindex_A, p_subindex_B);
 		SWAP(type_A, type_B);
+	} else if (type_A == type_B) {
+		// Don't depend on the order the broadphase reports the pair in, so pairs keep the same key
+		// for snapshots and deterministic stepping.
+		uint64_t id_A = A->get_self().get_id();
+		uint64_t id_B = B->get_self().get_id();
+		if (id_A > id_B || (id_A == id_B && p_subindex_A > p_subindex_B)) {
+			SWAP(A, B);
+			SWAP(p_subindex_A, p_subindex_B);
+		}
 	}
 
-	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
 	self->collision_pairs++;
 
 	if (type_A == GodotCollisionObject2D::TYPE_AREA) {
@@ -1036,6 +1046,13 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 
 	} else {
 		GodotBodyPair2D *b = memnew(GodotBodyPair2D(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B));
+		if (!self->pending_pair_states.is_empty()) {
+			HashMap<GodotConstraint2D::SortKey, GodotBodyPair2D::SavedState, GodotConstraint2D::SortKey>::Iterator E = self->pending_pair_states.find(b->get_sort_key());
+			if (E) {
+				b->apply_state(E->value);
+				self->pending_pair_states.remove(E);
+			}
+		}
 		return b;
 	}
 }
@@ -1142,6 +1159,160 @@ void GodotSpace2D::setup() {
 
 void GodotSpace2D::update() {
 	broadphase->update();
+	// Pairs that were not recreated by this update are not touching anymore.
+	pending_pair_states.clear();
+}
+
+namespace {
+
+const uint32_t SNAPSHOT_MAGIC = 0x53325047; // "GP2S"
+const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotBodySort {
+	_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+		return p_a->get_self().get_id() < p_b->get_self().get_id();
+	}
+};
+
+struct SnapshotPairSort {
+	_FORCE_INLINE_ bool operator()(const GodotBodyPair2D *p_a, const GodotBodyPair2D *p_b) const {
+		return p_a->get_sort_key() < p_b->get_sort_key();
+	}
+};
+
+} // namespace
+
+PackedByteArray GodotSpace2D::save_state() const {
+	LocalVector<GodotBody2D *> bodies;
+	LocalVector<GodotBodyPair2D *> pairs;
+
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		GodotBody2D *body = static_cast<GodotBody2D *>(E);
+		bodies.push_back(body);
+
+		for (const Pair<GodotConstraint2D *, int> &F : body->get_constraint_list()) {
+			// Each pair is listed by both of its bodies, only take it once.
+			if (F.first->is_body_pair() && F.first->get_body_ptr()[0] == body) {
+				pairs.push_back(static_cast<GodotBodyPair2D *>(F.first));
+			}
+		}
+	}
+
+	bodies.sort_custom<SnapshotBodySort>();
+	pairs.sort_custom<SnapshotPairSort>();
+
+	GodotSnapshotWriter2D writer;
+	writer.put(SNAPSHOT_MAGIC);
+	writer.put(SNAPSHOT_VERSION);
+	writer.put<uint32_t>(sizeof(real_t));
+
+	writer.put<uint32_t>(bodies.size());
+	for (const GodotBody2D *body : bodies) {
+		writer.put<uint64_t>(body->get_self().get_id());
+		uint32_t size_ofs = writer.data.size();
+		writer.put<uint32_t>(0);
+		body->save_state(writer);
+		uint32_t size = writer.data.size() - size_ofs - sizeof(uint32_t);
+		memcpy(&writer.data[size_ofs], &size, sizeof(uint32_t));
+	}
+
+	writer.put<uint32_t>(pairs.size());
+	for (const GodotBodyPair2D *pair : pairs) {
+		writer.put(pair->get_sort_key());
+		uint32_t size_ofs = writer.data.size();
+		writer.put<uint32_t>(0);
+		pair->save_state(writer);
+		uint32_t size = writer.data.size() - size_ofs - sizeof(uint32_t);
+		memcpy(&writer.data[size_ofs], &size, sizeof(uint32_t));
+	}
+
+	PackedByteArray state;
+	state.resize(writer.data.size());
+	memcpy(state.ptrw(), writer.data.ptr(), writer.data.size());
+	return state;
+}
+
+Error GodotSpace2D::restore_state(const PackedByteArray &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Space state can't be restored while the space is being stepped or queried.");
+
+	GodotSnapshotReader2D reader(p_state.ptr(), p_state.size());
+	ERR_FAIL_COND_V_MSG(reader.get<uint32_t>() != SNAPSHOT_MAGIC, ERR_FILE_CORRUPT, "Invalid physics space snapshot.");
+	ERR_FAIL_COND_V_MSG(reader.get<uint32_t>() != SNAPSHOT_VERSION, ERR_FILE_UNRECOGNIZED, "Unsupported physics space snapshot version.");
+	ERR_FAIL_COND_V_MSG(reader.get<uint32_t>() != sizeof(real_t), ERR_FILE_UNRECOGNIZED, "Physics space snapshot was saved with a different floating-point precision.");
+
+	HashMap<uint64_t, GodotBody2D *> bodies;
+	for (GodotCollisionObject2D *E : objects) {
+		if (E->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.insert(E->get_self().get_id(), static_cast<GodotBody2D *>(E));
+		}
+	}
+
+	// Read the whole snapshot before changing anything, so an invalid one leaves the space as it was.
+	LocalVector<Pair<GodotBody2D *, GodotBody2D::SavedState>> body_states;
+	uint32_t body_count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < body_count && !reader.failed; i++) {
+		uint64_t id = reader.get<uint64_t>();
+		uint32_t size = reader.get<uint32_t>();
+		ERR_FAIL_COND_V_MSG(reader.failed || size > size_t(reader.end - reader.ptr), ERR_FILE_CORRUPT, "Truncated physics space snapshot.");
+
+		GodotSnapshotReader2D body_reader(reader.ptr, size);
+		GodotBody2D::SavedState state;
+		ERR_FAIL_COND_V_MSG(!GodotBody2D::read_state(body_reader, state) || body_reader.ptr != body_reader.end, ERR_FILE_CORRUPT, "Invalid body record in physics space snapshot.");
+		reader.ptr += size;
+
+		// Bodies freed since the snapshot was saved are skipped.
+		HashMap<uint64_t, GodotBody2D *>::Iterator E = bodies.find(id);
+		if (E) {
+			body_states.push_back(Pair<GodotBody2D *, GodotBody2D::SavedState>(E->value, state));
+		}
+	}
+
+	LocalVector<Pair<GodotConstraint2D::SortKey, GodotBodyPair2D::SavedState>> pair_states;
+	uint32_t pair_count = reader.get<uint32_t>();
+	for (uint32_t i = 0; i < pair_count && !reader.failed; i++) {
+		GodotConstraint2D::SortKey key = reader.get<GodotConstraint2D::SortKey>();
+		uint32_t size = reader.get<uint32_t>();
+		ERR_FAIL_COND_V_MSG(reader.failed || size > size_t(reader.end - reader.ptr), ERR_FILE_CORRUPT, "Truncated physics space snapshot.");
+
+		GodotSnapshotReader2D pair_reader(reader.ptr, size);
+		GodotBodyPair2D::SavedState state;
+		ERR_FAIL_COND_V_MSG(!GodotBodyPair2D::read_state(pair_reader, state) || pair_reader.ptr != pair_reader.end, ERR_FILE_CORRUPT, "Invalid contact record in physics space snapshot.");
+		reader.ptr += size;
+		pair_states.push_back(Pair<GodotConstraint2D::SortKey, GodotBodyPair2D::SavedState>(key, state));
+	}
+
+	ERR_FAIL_COND_V_MSG(reader.failed || reader.ptr != reader.end, ERR_FILE_CORRUPT, "Invalid physics space snapshot size.");
+
+	for (const Pair<GodotBody2D *, GodotBody2D::SavedState> &E : body_states) {
+		E.first->apply_state(E.second);
+	}
+
+	// Pairs that still exist take their saved contacts, or start over if they weren't touching when the snapshot was saved.
+	// The others get theirs when the next broadphase update creates them.
+	pending_pair_states.clear();
+	for (const Pair<GodotConstraint2D::SortKey, GodotBodyPair2D::SavedState> &E : pair_states) {
+		pending_pair_states.insert(E.first, E.second);
+	}
+	for (const KeyValue<uint64_t, GodotBody2D *> &E : bodies) {
+		for (const Pair<GodotConstraint2D *, int> &F : E.value->get_constraint_list()) {
+			if (!F.first->is_body_pair() || F.first->get_body_ptr()[0] != E.value) {
+				continue;
+			}
+			GodotBodyPair2D *pair = static_cast<GodotBodyPair2D *>(F.first);
+			HashMap<GodotConstraint2D::SortKey, GodotBodyPair2D::SavedState, GodotConstraint2D::SortKey>::Iterator G = pending_pair_states.find(pair->get_sort_key());
+			if (G) {
+				pair->apply_state(G->value);
+				pending_pair_states.remove(G);
+			} else {
+				pair->reset_state();
+			}
+		}
+	}
+
+	return OK;
 }
 
 void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value) {
@@ -32,8 +32,10 @@
 
 #include "godot_area_2d.h"
 #include "godot_body_2d.h"
+#include "godot_body_pair_2d.h"
 #include "godot_broad_phase_2d.h"
 #include "godot_collision_object_2d.h"
+#include "godot_constraint_2d.h"
 
 #include "core/typedefs.h"
 
@@ -111,6 +113,10 @@ private:
 	real_t body_time_to_sleep = 0.0;
 
 	bool locked = false;
+	bool deterministic = false;
+
+	// Contact states from a restored snapshot whose pairs are created by the next broadphase update.
+	HashMap<GodotConstraint2D::SortKey, GodotBodyPair2D::SavedState, GodotConstraint2D::SortKey> pending_pair_states;
 
 	real_t last_step = 0.001;
 
@@ -171,6 +177,12 @@ public:
 	void lock();
 	void unlock();
 
+	void set_deterministic(bool p_enable) { deterministic = p_enable; }
+	bool is_deterministic() const { return deterministic; }
+
+	PackedByteArray save_state() const;
+	Error restore_state(const PackedByteArray &p_state);
+
 	real_t get_last_step() const { return last_step; }
 	void set_last_step(real_t p_step) { last_step = p_step; }
 
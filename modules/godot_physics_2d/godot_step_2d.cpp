@@ -32,6 +32,7 @@
 
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/sort_array.h"
 #include "godot_constraint_2d.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
@@ -126,6 +127,20 @@ void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) cons
 	}
 }
 
+void GodotStep2D::_sort_islands(uint32_t p_island_count) {
+	// Constraints are discovered in broadphase and active list order, which isn't reproducible between runs.
+	// Order them by the ids of what they connect so they are always solved in the same sequence.
+	island_order.resize(p_island_count);
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		constraint_islands[island_index].sort_custom<ConstraintSort>();
+		island_order[island_index] = island_index;
+	}
+
+	SortArray<uint32_t, IslandSort> sorter;
+	sorter.compare.islands = &constraint_islands;
+	sorter.sort(island_order.ptr(), p_island_count);
+}
+
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -232,6 +247,11 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	p_space->set_island_count((int)island_count);
 
+	const bool deterministic = p_space->is_deterministic();
+	if (deterministic) {
+		_sort_islands(island_count);
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
@@ -254,7 +274,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	// WARNING: This doesn't run on threads, because it involves thread-unsafe processing.
 	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
+		_pre_solve_island(constraint_islands[deterministic ? island_order[island_index] : island_index]);
 	}
 
 	/* SOLVE CONSTRAINT ISLANDS */
@@ -43,12 +43,27 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
+	LocalVector<uint32_t> island_order;
+
+	struct ConstraintSort {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+			return p_a->get_sort_key() < p_b->get_sort_key();
+		}
+	};
+
+	struct IslandSort {
+		const LocalVector<LocalVector<GodotConstraint2D *>> *islands = nullptr;
+		_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+			return (*islands)[p_a][0]->get_sort_key() < (*islands)[p_b][0]->get_sort_key();
+		}
+	};
 
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
 	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _sort_islands(uint32_t p_island_count);
 
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
@@ -0,0 +1,177 @@
+/**************************************************************************/
+/*  test_godot_physics_2d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/physics_2d/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysics2D {
+
+struct BoxStack {
+	RID space;
+	RID box_shape;
+	RID floor_shape;
+	RID floor;
+	LocalVector<RID> boxes;
+
+	BoxStack(int p_box_count, bool p_deterministic) {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+		ps->space_set_deterministic(space, p_deterministic);
+		ps->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+		ps->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+		floor_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(floor_shape, Vector2(500, 10));
+		floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 10)));
+		ps->body_set_space(floor, space);
+
+		box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(10, 10));
+		for (int i = 0; i < p_box_count; i++) {
+			RID box = ps->body_create();
+			ps->body_set_mode(box, PhysicsServer2D::BODY_MODE_RIGID);
+			ps->body_add_shape(box, box_shape);
+			// Slightly staggered and dropped from a small height, so contacts shift while the stack settles.
+			ps->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(1.0 * (i % 2), -11.0 - 21.0 * i)));
+			ps->body_set_space(box, space);
+			boxes.push_back(box);
+		}
+	}
+
+	~BoxStack() {
+		PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+		for (const RID &box : boxes) {
+			ps->free_rid(box);
+		}
+		ps->free_rid(floor);
+		ps->free_rid(box_shape);
+		ps->free_rid(floor_shape);
+		ps->free_rid(space);
+	}
+
+	LocalVector<Transform2D> get_transforms() const {
+		LocalVector<Transform2D> transforms;
+		for (const RID &box : boxes) {
+			transforms.push_back(PhysicsServer2D::get_singleton()->body_get_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM));
+		}
+		return transforms;
+	}
+};
+
+static void step_physics(int p_steps) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	for (int i = 0; i < p_steps; i++) {
+		ps->sync();
+		ps->flush_queries();
+		ps->end_sync();
+		ps->step(1.0 / 60.0);
+	}
+}
+
+static bool are_transforms_identical(const LocalVector<Transform2D> &p_a, const LocalVector<Transform2D> &p_b) {
+	return p_a.size() == p_b.size() && memcmp(p_a.ptr(), p_b.ptr(), p_a.size() * sizeof(Transform2D)) == 0;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Restoring a snapshot replays the same steps") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	BoxStack stack(6, true);
+
+	// Let the boxes land, so the snapshot holds resting contacts.
+	step_physics(60);
+	const PackedByteArray snapshot = ps->space_save_state(stack.space);
+	REQUIRE(!snapshot.is_empty());
+
+	step_physics(60);
+	const LocalVector<Transform2D> first_run = stack.get_transforms();
+	const PackedByteArray first_run_state = ps->space_save_state(stack.space);
+
+	CHECK(ps->space_restore_state(stack.space, snapshot) == OK);
+	CHECK(ps->space_save_state(stack.space) == snapshot);
+
+	step_physics(60);
+	CHECK(are_transforms_identical(stack.get_transforms(), first_run));
+	CHECK(ps->space_save_state(stack.space) == first_run_state);
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Invalid snapshots are rejected without changing the space") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	BoxStack stack(3, true);
+
+	step_physics(30);
+	const PackedByteArray snapshot = ps->space_save_state(stack.space);
+	step_physics(30);
+	const PackedByteArray current = ps->space_save_state(stack.space);
+	REQUIRE(snapshot != current);
+
+	ERR_PRINT_OFF;
+	// Cut in the middle of the last record, after all bodies could have been read.
+	const PackedByteArray truncated = snapshot.slice(0, snapshot.size() - 3);
+	CHECK(ps->space_restore_state(stack.space, truncated) != OK);
+	CHECK(ps->space_save_state(stack.space) == current);
+
+	PackedByteArray wrong_magic = snapshot;
+	wrong_magic.set(0, wrong_magic[0] ^ 0xFF);
+	CHECK(ps->space_restore_state(stack.space, wrong_magic) != OK);
+	CHECK(ps->space_save_state(stack.space) == current);
+
+	CHECK(ps->space_restore_state(stack.space, PackedByteArray()) != OK);
+	CHECK(ps->space_save_state(stack.space) == current);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[SceneTree][GodotPhysics2D] Contacts survive a restore outside of deterministic mode") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	BoxStack stack(3, false);
+
+	step_physics(60);
+	const PackedByteArray snapshot = ps->space_save_state(stack.space);
+
+	// Removing and re-adding the boxes in reverse order recreates their pairs, in whatever order the broadphase reports them.
+	for (const RID &box : stack.boxes) {
+		ps->body_set_space(box, RID());
+	}
+	for (int i = stack.boxes.size() - 1; i >= 0; i--) {
+		ps->body_set_space(stack.boxes[i], stack.space);
+	}
+	step_physics(1);
+
+	// The recreated pairs still match their saved records.
+	CHECK(ps->space_restore_state(stack.space, snapshot) == OK);
+	CHECK(ps->space_save_state(stack.space) == snapshot);
+}
+
+} // namespace TestGodotPhysics2D
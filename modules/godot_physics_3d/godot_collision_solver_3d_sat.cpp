@@ -38,6 +38,13 @@
 
 #define _BACKFACE_NORMAL_THRESHOLD -0.0002
 
+// SSE2 is part of the x86_64 baseline, so the vectorized projection kernels
+// are selected at compile time. Other targets use the scalar loops.
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(REAL_T_IS_DOUBLE)
+#define SAT_PROJECT_SSE2
+#include <emmintrin.h>
+#endif
+
 // Cylinder SAT analytic methods and face-circle contact points for cylinder-trimesh and cylinder-box collision are based on ODE colliders.
 
 /*
@@ -614,6 +621,189 @@ static void _generate_contacts_from_supports(const Vector3 *p_points_A, int p_po
 	contacts_func(points_A, pointcount_A, points_B, pointcount_B, p_callback);
 }
 
+/****** BATCHED AXIS PROJECTION *******/
+
+#ifdef TESTS_ENABLED
+static bool sat_batched_axis_projection = true;
+
+void sat_set_batched_axis_projection(bool p_enabled) {
+	sat_batched_axis_projection = p_enabled;
+}
+#else
+static constexpr bool sat_batched_axis_projection = true;
+#endif
+
+// Candidate separating axes in structure-of-arrays form, so that several of
+// them can be projected at once. They are still tested in the order they were
+// added, which keeps early outs and the chosen axis the same as testing them
+// one at a time.
+struct SATAxes {
+	static const int MAX_AXES = 16;
+
+	alignas(16) real_t x[MAX_AXES];
+	alignas(16) real_t y[MAX_AXES];
+	alignas(16) real_t z[MAX_AXES];
+	int count = 0;
+
+	_FORCE_INLINE_ void push(const Vector3 &p_axis) {
+		x[count] = p_axis.x;
+		y[count] = p_axis.y;
+		z[count] = p_axis.z;
+		count++;
+	}
+
+	_FORCE_INLINE_ Vector3 get(int p_index) const {
+		return Vector3(x[p_index], y[p_index], z[p_index]);
+	}
+};
+
+// Vertices of a small convex shape, transformed to world space once per pair
+// instead of once per axis as project_range() does.
+struct SATPoints {
+	static const int MAX_POINTS = 64;
+
+	alignas(16) real_t x[MAX_POINTS];
+	alignas(16) real_t y[MAX_POINTS];
+	alignas(16) real_t z[MAX_POINTS];
+	int count = 0;
+
+	// Returns false if there are too many (or no) points, if project_range()
+	// wouldn't scan all of them, or if batching is turned off. The shape must
+	// then be projected with project_range().
+	bool set_transformed(const GodotConvexPolygonShape3D *p_shape, const Transform3D &p_transform) {
+		const LocalVector<Vector3> &points = p_shape->get_mesh().vertices;
+		const int point_count = points.size();
+		if (!sat_batched_axis_projection || point_count == 0 || point_count > MAX_POINTS || !p_shape->is_projected_by_vertex_scan()) {
+			return false;
+		}
+		for (int i = 0; i < point_count; i++) {
+			Vector3 p = p_transform.xform(points[i]);
+			x[i] = p.x;
+			y[i] = p.y;
+			z[i] = p.z;
+		}
+		count = point_count;
+		return true;
+	}
+};
+
+// Same as GodotBoxShape3D::project_range() for each axis, four axes at a time.
+static void _sat_project_box(const Vector3 &p_half_extents, const Transform3D &p_transform, const SATAxes &p_axes, real_t *r_min, real_t *r_max) {
+	const Basis &b = p_transform.basis;
+	const Vector3 &o = p_transform.origin;
+	int i = 0;
+
+#ifdef SAT_PROJECT_SSE2
+	const __m128 sign_mask = _mm_set1_ps(-0.0f);
+	const __m128 hx = _mm_set1_ps(p_half_extents.x);
+	const __m128 hy = _mm_set1_ps(p_half_extents.y);
+	const __m128 hz = _mm_set1_ps(p_half_extents.z);
+
+	for (; i + 4 <= p_axes.count; i += 4) {
+		const __m128 nx = _mm_load_ps(&p_axes.x[i]);
+		const __m128 ny = _mm_load_ps(&p_axes.y[i]);
+		const __m128 nz = _mm_load_ps(&p_axes.z[i]);
+
+		// basis.xform_inv(axis), then abs().dot(half_extents).
+		__m128 l = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(b.rows[0][0]), nx), _mm_mul_ps(_mm_set1_ps(b.rows[1][0]), ny)), _mm_mul_ps(_mm_set1_ps(b.rows[2][0]), nz));
+		__m128 length = _mm_mul_ps(_mm_andnot_ps(sign_mask, l), hx);
+		l = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(b.rows[0][1]), nx), _mm_mul_ps(_mm_set1_ps(b.rows[1][1]), ny)), _mm_mul_ps(_mm_set1_ps(b.rows[2][1]), nz));
+		length = _mm_add_ps(length, _mm_mul_ps(_mm_andnot_ps(sign_mask, l), hy));
+		l = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(b.rows[0][2]), nx), _mm_mul_ps(_mm_set1_ps(b.rows[1][2]), ny)), _mm_mul_ps(_mm_set1_ps(b.rows[2][2]), nz));
+		length = _mm_add_ps(length, _mm_mul_ps(_mm_andnot_ps(sign_mask, l), hz));
+
+		const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_set1_ps(o.x)), _mm_mul_ps(ny, _mm_set1_ps(o.y))), _mm_mul_ps(nz, _mm_set1_ps(o.z)));
+
+		_mm_storeu_ps(&r_min[i], _mm_sub_ps(distance, length));
+		_mm_storeu_ps(&r_max[i], _mm_add_ps(distance, length));
+	}
+#endif
+
+	for (; i < p_axes.count; i++) {
+		const Vector3 axis = p_axes.get(i);
+		const real_t length = b.xform_inv(axis).abs().dot(p_half_extents);
+		const real_t distance = axis.dot(o);
+		r_min[i] = distance - length;
+		r_max[i] = distance + length;
+	}
+}
+
+// Projects world space points on each axis, four points at a time. The
+// results are the same bits project_range() gives: the dot products are
+// evaluated in the same order, and the min/max operands are ordered so that
+// NaNs and ties keep the earlier value, like its comparisons do. Only the sign
+// of a zero result could depend on which tied vertex is kept, so those axes are
+// scanned again in vertex order.
+static void _sat_project_points(const SATPoints &p_points, const SATAxes &p_axes, real_t *r_min, real_t *r_max) {
+	for (int a = 0; a < p_axes.count; a++) {
+		const real_t ax = p_axes.x[a];
+		const real_t ay = p_axes.y[a];
+		const real_t az = p_axes.z[a];
+		real_t d_min = ax * p_points.x[0] + ay * p_points.y[0] + az * p_points.z[0];
+		real_t d_max = d_min;
+		int i = 1;
+
+#ifdef SAT_PROJECT_SSE2
+		if (p_points.count >= 4) {
+			const __m128 nx = _mm_set1_ps(ax);
+			const __m128 ny = _mm_set1_ps(ay);
+			const __m128 nz = _mm_set1_ps(az);
+			__m128 v_min = _mm_set1_ps(d_min);
+			__m128 v_max = v_min;
+
+			for (i = 0; i + 4 <= p_points.count; i += 4) {
+				const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_load_ps(&p_points.x[i])), _mm_mul_ps(ny, _mm_load_ps(&p_points.y[i]))), _mm_mul_ps(nz, _mm_load_ps(&p_points.z[i])));
+				v_min = _mm_min_ps(d, v_min);
+				v_max = _mm_max_ps(d, v_max);
+			}
+
+			v_min = _mm_min_ps(_mm_shuffle_ps(v_min, v_min, _MM_SHUFFLE(1, 0, 3, 2)), v_min);
+			v_min = _mm_min_ps(_mm_shuffle_ps(v_min, v_min, _MM_SHUFFLE(2, 3, 0, 1)), v_min);
+			v_max = _mm_max_ps(_mm_shuffle_ps(v_max, v_max, _MM_SHUFFLE(1, 0, 3, 2)), v_max);
+			v_max = _mm_max_ps(_mm_shuffle_ps(v_max, v_max, _MM_SHUFFLE(2, 3, 0, 1)), v_max);
+			d_min = _mm_cvtss_f32(v_min);
+			d_max = _mm_cvtss_f32(v_max);
+
+			if (d_min == 0.0f || d_max == 0.0f) {
+				d_min = ax * p_points.x[0] + ay * p_points.y[0] + az * p_points.z[0];
+				d_max = d_min;
+				i = 1;
+			}
+		}
+#endif
+
+		for (; i < p_points.count; i++) {
+			const real_t d = ax * p_points.x[i] + ay * p_points.y[i] + az * p_points.z[i];
+			if (d > d_max) {
+				d_max = d;
+			}
+			if (d < d_min) {
+				d_min = d;
+			}
+		}
+
+		r_min[a] = d_min;
+		r_max[a] = d_max;
+	}
+}
+
+static _FORCE_INLINE_ void _sat_project_axes(const GodotShape3D *p_shape, const Transform3D &p_transform, const SATPoints *p_points, const SATAxes &p_axes, real_t *r_min, real_t *r_max) {
+	if (p_points) {
+		_sat_project_points(*p_points, p_axes, r_min, r_max);
+		return;
+	}
+
+	for (int i = 0; i < p_axes.count; i++) {
+		r_min[i] = 0.0;
+		r_max[i] = 0.0;
+		p_shape->project_range(p_axes.get(i), p_transform, r_min[i], r_max[i]);
+	}
+}
+
+static _FORCE_INLINE_ void _sat_project_axes(const GodotBoxShape3D *p_shape, const Transform3D &p_transform, const SATPoints *p_points, const SATAxes &p_axes, real_t *r_min, real_t *r_max) {
+	_sat_project_box(p_shape->get_half_extents(), p_transform, p_axes, r_min, r_max);
+}
+
 template <typename ShapeA, typename ShapeB, bool withMargin = false>
 class SeparatorAxisTest {
 	const ShapeA *shape_A = nullptr;
@@ -625,6 +815,50 @@ class SeparatorAxisTest {
 	real_t margin_A = 0.0;
 	real_t margin_B = 0.0;
 	Vector3 separator_axis;
+	const SATPoints *points_A = nullptr;
+	const SATPoints *points_B = nullptr;
+	SATAxes queued_axes;
+	bool queued_separated = false; // Only used when batching is turned off.
+
+	_FORCE_INLINE_ bool _test_axis_range(const Vector3 &p_axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B) {
+		if (withMargin) {
+			min_A -= margin_A;
+			max_A += margin_A;
+			min_B -= margin_B;
+			max_B += margin_B;
+		}
+
+		min_B -= (max_A - min_A) * 0.5;
+		max_B += (max_A - min_A) * 0.5;
+
+		min_B -= (min_A + max_A) * 0.5;
+		max_B -= (min_A + max_A) * 0.5;
+
+		if (min_B > 0.0 || max_B < 0.0) {
+			separator_axis = p_axis;
+			return false; // doesn't contain 0
+		}
+
+		//use the smallest depth
+
+		if (min_B < 0.0) { // could be +0.0, we don't want it to become -0.0
+			min_B = -min_B;
+		}
+
+		if (max_B < min_B) {
+			if (max_B < best_depth) {
+				best_depth = max_B;
+				best_axis = p_axis;
+			}
+		} else {
+			if (min_B < best_depth) {
+				best_depth = min_B;
+				best_axis = -p_axis; // keep it as A axis
+			}
+		}
+
+		return true;
+	}
 
 public:
 	Vector3 best_axis;
@@ -650,45 +884,63 @@ public:
 		shape_A->project_range(axis, *transform_A, min_A, max_A);
 		shape_B->project_range(axis, *transform_B, min_B, max_B);
 
-		if (withMargin) {
-			min_A -= margin_A;
-			max_A += margin_A;
-			min_B -= margin_B;
-			max_B += margin_B;
+		return _test_axis_range(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Queues an axis to be tested in a batch with the next ones. Returns false
+	// if the batch filled up and one of its axes separates the shapes.
+	// Queued axes must be flushed with test_queued_axes() before any other test.
+	_FORCE_INLINE_ bool queue_axis(const Vector3 &p_axis) {
+		if (!sat_batched_axis_projection) {
+			// Stop at the first separating axis, as a batch does, and let test_queued_axes() report it.
+			queued_separated = queued_separated || !test_axis(p_axis);
+			return !queued_separated;
 		}
 
-		min_B -= (max_A - min_A) * 0.5;
-		max_B += (max_A - min_A) * 0.5;
+		if (p_axis.is_zero_approx()) {
+			// strange case, try an upwards separator
+			queued_axes.push(Vector3(0.0, 1.0, 0.0));
+		} else {
+			queued_axes.push(p_axis);
+		}
 
-		min_B -= (min_A + max_A) * 0.5;
-		max_B -= (min_A + max_A) * 0.5;
+		if (queued_axes.count == SATAxes::MAX_AXES) {
+			return test_queued_axes();
+		}
+		return true;
+	}
 
-		if (min_B > 0.0 || max_B < 0.0) {
-			separator_axis = axis;
-			return false; // doesn't contain 0
+	bool test_queued_axes() {
+		if (queued_axes.count == 0) {
+			return !queued_separated;
 		}
 
-		//use the smallest depth
+		real_t min_A[SATAxes::MAX_AXES];
+		real_t max_A[SATAxes::MAX_AXES];
+		real_t min_B[SATAxes::MAX_AXES];
+		real_t max_B[SATAxes::MAX_AXES];
 
-		if (min_B < 0.0) { // could be +0.0, we don't want it to become -0.0
-			min_B = -min_B;
-		}
+		_sat_project_axes(shape_A, *transform_A, points_A, queued_axes, min_A, max_A);
+		_sat_project_axes(shape_B, *transform_B, points_B, queued_axes, min_B, max_B);
 
-		if (max_B < min_B) {
-			if (max_B < best_depth) {
-				best_depth = max_B;
-				best_axis = axis;
-			}
-		} else {
-			if (min_B < best_depth) {
-				best_depth = min_B;
-				best_axis = -axis; // keep it as A axis
+		const int count = queued_axes.count;
+		queued_axes.count = 0;
+
+		for (int i = 0; i < count; i++) {
+			if (!_test_axis_range(queued_axes.get(i), min_A[i], max_A[i], min_B[i], max_B[i])) {
+				return false;
 			}
 		}
 
 		return true;
 	}
 
+	// Projects the shapes using points transformed once per pair, see SATPoints.
+	_FORCE_INLINE_ void set_points(const SATPoints *p_points_A, const SATPoints *p_points_B) {
+		points_A = p_points_A;
+		points_B = p_points_B;
+	}
+
 	static _FORCE_INLINE_ void test_contact_points(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 		SeparatorAxisTest<ShapeA, ShapeB, withMargin> *separator = (SeparatorAxisTest<ShapeA, ShapeB, withMargin> *)p_userdata;
 		Vector3 axis = (p_point_B - p_point_A);
@@ -1081,24 +1333,18 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
-	// test faces of A
+	// test faces of A and B
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		separator.queue_axis(p_transform_a.basis.get_column(i).normalized());
 	}
 
-	// test faces of B
-
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
+		separator.queue_axis(p_transform_b.basis.get_column(i).normalized());
+	}
 
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+	if (!separator.test_queued_axes()) {
+		return;
 	}
 
 	// test combined edges
@@ -1111,12 +1357,14 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			}
 			axis.normalize();
 
-			if (!separator.test_axis(axis)) {
-				return;
-			}
+			separator.queue_axis(axis);
 		}
 	}
 
+	if (!separator.test_queued_axes()) {
+		return;
+	}
+
 	if (withMargin) {
 		//add endpoint test between closest vertices and edges
 
@@ -1399,13 +1647,14 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	const Vector3 *vertices = mesh.vertices.ptr();
 	int vertex_count = mesh.vertices.size();
 
+	SATPoints points_B;
+	if (points_B.set_transformed(convex_polygon_B, p_transform_b)) {
+		separator.set_points(nullptr, &points_B);
+	}
+
 	// faces of A
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		separator.queue_axis(p_transform_a.basis.get_column(i).normalized());
 	}
 
 	// Precalculating this makes the transforms faster.
@@ -1415,11 +1664,15 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
 
+	if (!separator.test_queued_axes()) {
+		return;
+	}
+
 	// A<->B edges
 	for (int i = 0; i < 3; i++) {
 		Vector3 e1 = p_transform_a.basis.get_column(i);
@@ -1429,12 +1682,16 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 			Vector3 axis = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
 	}
 
+	if (!separator.test_queued_axes()) {
+		return;
+	}
+
 	if (withMargin) {
 		// calculate closest points between vertices and box edges
 		for (int v = 0; v < vertex_count; v++) {
@@ -1707,6 +1964,11 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 	int edge_count = mesh.edges.size();
 	const Vector3 *vertices = mesh.vertices.ptr();
 
+	SATPoints points_B;
+	if (points_B.set_transformed(convex_polygon_B, p_transform_b)) {
+		separator.set_points(nullptr, &points_B);
+	}
+
 	// Precalculating this makes the transforms faster.
 	Basis b_xform_normal = p_transform_b.basis.inverse().transposed();
 
@@ -1714,7 +1976,7 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 	for (int i = 0; i < face_count; i++) {
 		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -1726,11 +1988,15 @@ static void _collision_capsule_convex_polygon(const GodotShape3D *p_a, const Tra
 		Vector3 edge_axis = p_transform_b.basis.xform(vertices[edges[i].vertex_a]) - p_transform_b.basis.xform(vertices[edges[i].vertex_b]);
 		Vector3 axis = edge_axis.cross(p_transform_a.basis.get_column(1)).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
 
+	if (!separator.test_queued_axes()) {
+		return;
+	}
+
 	// capsule balls, edges of B
 
 	for (int i = 0; i < 2; i++) {
@@ -2066,6 +2332,12 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	const Vector3 *vertices_B = mesh_B.vertices.ptr();
 	int vertex_count_B = mesh_B.vertices.size();
 
+	SATPoints points_A;
+	SATPoints points_B;
+	separator.set_points(
+			points_A.set_transformed(convex_polygon_A, p_transform_a) ? &points_A : nullptr,
+			points_B.set_transformed(convex_polygon_B, p_transform_b) ? &points_B : nullptr);
+
 	// Precalculating this makes the transforms faster.
 	Basis a_xform_normal = p_transform_a.basis.inverse().transposed();
 
@@ -2073,7 +2345,7 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_A; i++) {
 		Vector3 axis = a_xform_normal.xform(faces_A[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
@@ -2085,11 +2357,15 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 	for (int i = 0; i < face_count_B; i++) {
 		Vector3 axis = b_xform_normal.xform(faces_B[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
+		if (!separator.queue_axis(axis)) {
 			return;
 		}
 	}
 
+	if (!separator.test_queued_axes()) {
+		return;
+	}
+
 	// A<->B edges
 
 	for (int i = 0; i < edge_count_A; i++) {
@@ -2109,13 +2385,17 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
 				Vector3 axis = e1.cross(e2).normalized();
 
-				if (!separator.test_axis(axis)) {
+				if (!separator.queue_axis(axis)) {
 					return;
 				}
 			}
 		}
 	}
 
+	if (!separator.test_queued_axes()) {
+		return;
+	}
+
 	if (withMargin) {
 		//vertex-vertex
 		for (int i = 0; i < vertex_count_A; i++) {
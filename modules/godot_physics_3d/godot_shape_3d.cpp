@@ -815,7 +815,7 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 
 	const Vector3 *vrts = &mesh.vertices[0];
 
-	if (vertex_count > 3 * extreme_vertices.size()) {
+	if (!is_projected_by_vertex_scan()) {
 		// For a large mesh, two calls to get_support() is faster than a full
 		// scan over all vertices.
 
@@ -283,6 +283,8 @@ struct GodotConvexPolygonShape3D : public GodotShape3D {
 
 public:
 	const Geometry3D::MeshData &get_mesh() const { return mesh; }
+	// Large meshes are projected with two get_support() calls instead of a scan over all vertices.
+	bool is_projected_by_vertex_scan() const { return mesh.vertices.size() <= 3 * extreme_vertices.size(); }
 
 	virtual PhysicsServer3D::ShapeType get_type() const override { return PhysicsServer3D::SHAPE_CONVEX_POLYGON; }
 
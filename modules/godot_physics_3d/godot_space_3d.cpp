@@ -34,6 +34,8 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/frame_arena.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_pair_3d.h"
 
@@ -107,18 +109,10 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
-	Vector3 begin, end;
-	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
-
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
-	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
+// Closest intersection of the segment from `p_begin` to `p_end` with the given broad phase results. With
+// `p_check_aabb`, results whose AABB the segment doesn't cross are skipped, for results culled by a larger volume.
+static bool _intersect_ray_with(const PhysicsDirectSpaceState3D::RayParameters &p_parameters, const Vector3 &p_begin, const Vector3 &p_end, uint32_t p_collision_mask, GodotCollisionObject3D *const *p_results, const int *p_subindex_results, int p_amount, bool p_check_aabb, PhysicsDirectSpaceState3D::RayResult &r_result) {
+	Vector3 normal = (p_end - p_begin).normalized();
 
 	bool collided = false;
 	Vector3 res_point, res_normal;
@@ -127,26 +121,32 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_results[i], p_collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_results[i];
+
+		int shape_idx = p_subindex_results[i];
+
+		// Soft bodies don't keep their shape AABB up to date.
+		if (p_check_aabb && col_obj->get_type() != GodotCollisionObject3D::TYPE_SOFT_BODY && !col_obj->get_shape_aabb(shape_idx).intersects_segment(p_begin, p_end)) {
+			continue;
+		}
 
-		int shape_idx = space->intersection_query_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
-		Vector3 local_from = inv_xform.xform(begin);
-		Vector3 local_to = inv_xform.xform(end);
+		Vector3 local_from = inv_xform.xform(p_begin);
+		Vector3 local_to = inv_xform.xform(p_end);
 
 		const GodotShape3D *shape = col_obj->get_shape(shape_idx);
 
@@ -157,7 +157,7 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 			if (p_parameters.hit_from_inside) {
 				// Hit shape at starting point.
 				min_d = 0;
-				res_point = begin;
+				res_point = p_begin;
 				res_normal = Vector3();
 				res_shape = shape_idx;
 				res_obj = col_obj;
@@ -207,6 +207,152 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
+
+	return _intersect_ray_with(p_parameters, p_parameters.from, p_parameters.to, p_parameters.collision_mask, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, r_result);
+}
+
+// Spreads the low 10 bits of `p_value` to every third bit, to interleave three coordinates into a Morton code.
+static uint32_t _spread_morton_bits(uint32_t p_value) {
+	p_value = (p_value | (p_value << 16)) & 0x030000FF;
+	p_value = (p_value | (p_value << 8)) & 0x0300F00F;
+	p_value = (p_value | (p_value << 4)) & 0x030C30C3;
+	p_value = (p_value | (p_value << 2)) & 0x09249249;
+	return p_value;
+}
+
+struct RayBatchSortKey {
+	uint32_t code = 0;
+	uint32_t index = 0;
+
+	bool operator<(const RayBatchSortKey &p_other) const {
+		return code < p_other.code || (code == p_other.code && index < p_other.index);
+	}
+};
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_packet(uint32_t p_packet, RayBatch *p_batch) {
+	const uint32_t candidates_begin = p_batch->packet_candidates[p_packet];
+	const int candidate_count = p_batch->packet_candidates[p_packet + 1] - candidates_begin;
+	GodotCollisionObject3D *const *candidates = p_batch->candidates.ptr() + candidates_begin;
+	const int *candidate_shapes = p_batch->candidate_shapes.ptr() + candidates_begin;
+
+	for (uint32_t ray = p_batch->packet_rays[p_packet]; ray < p_batch->packet_rays[p_packet + 1]; ray++) {
+		const uint32_t i = p_batch->order[ray];
+		const uint32_t collision_mask = p_batch->collision_masks ? p_batch->collision_masks[i] : p_batch->parameters->collision_mask;
+		p_batch->hits[i] = _intersect_ray_with(*p_batch->parameters, p_batch->from[i], p_batch->to[i], collision_mask, candidates, candidate_shapes, candidate_count, true, p_batch->results[i]);
+	}
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, const uint32_t *p_collision_masks, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.collision_masks = p_collision_masks;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	// Sort the rays along a Morton curve of their origins, so rays cast from the same place (such as all the rays
+	// of an agent) end up next to each other even when the batch interleaves them.
+	AABB origin_bounds(p_from[0], Vector3());
+	for (int i = 1; i < p_count; i++) {
+		origin_bounds.expand_to(p_from[i]);
+	}
+	FrameLocalVector<RayBatchSortKey> keys;
+	keys.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Vector3 cell = p_from[i] - origin_bounds.position;
+		for (int axis = 0; axis < 3; axis++) {
+			cell[axis] = origin_bounds.size[axis] > 0 ? cell[axis] * 1023 / origin_bounds.size[axis] : 0;
+		}
+		keys[i].code = _spread_morton_bits((uint32_t)cell.x) | (_spread_morton_bits((uint32_t)cell.y) << 1) | (_spread_morton_bits((uint32_t)cell.z) << 2);
+		keys[i].index = i;
+	}
+	keys.sort();
+
+	// Neighboring rays whose segments overlap are grouped in packets that traverse the broad phase only once, with
+	// their bounds. A ray that doesn't touch the bounds of the current packet starts a new one, so incoherent rays
+	// are culled on their own instead of with bounds that span the whole space.
+	batch.order.resize(p_count);
+	batch.packet_rays.push_back(0);
+	FrameLocalVector<AABB> packet_bounds;
+	for (uint32_t ray = 0; ray < (uint32_t)p_count; ray++) {
+		const uint32_t i = keys[ray].index;
+		batch.order[ray] = i;
+
+		AABB segment(p_from[i], Vector3());
+		segment.expand_to(p_to[i]);
+		if (ray == 0) {
+			packet_bounds.push_back(segment);
+			continue;
+		}
+		AABB &bounds = packet_bounds[packet_bounds.size() - 1];
+		if (ray - batch.packet_rays[batch.packet_rays.size() - 1] < (uint32_t)RAY_BATCH_PACKET_SIZE && bounds.intersects_inclusive(segment)) {
+			bounds.merge_with(segment);
+		} else {
+			batch.packet_rays.push_back(ray);
+			packet_bounds.push_back(segment);
+		}
+	}
+	batch.packet_rays.push_back(p_count);
+
+	// The broad phase is not thread-safe, so it's culled here, and only the narrow phase tests of each packet run in parallel.
+	const uint32_t packet_count = packet_bounds.size();
+	batch.packet_candidates.resize(packet_count + 1);
+	batch.packet_candidates[0] = 0;
+
+	for (uint32_t packet = 0; packet < packet_count; packet++) {
+		const AABB &bounds = packet_bounds[packet];
+
+		// Unlike single queries, a packet must not miss any result, so cull again with more room if it's full.
+		const uint32_t offset = batch.candidates.size();
+		int max_results = GodotSpace3D::INTERSECTION_QUERY_MAX;
+		while (true) {
+			batch.candidates.resize(offset + max_results);
+			batch.candidate_shapes.resize(offset + max_results);
+			const int amount = space->broadphase->cull_aabb(bounds, batch.candidates.ptr() + offset, max_results, batch.candidate_shapes.ptr() + offset);
+			if (amount < max_results) {
+				batch.candidates.resize(offset + amount);
+				batch.candidate_shapes.resize(offset + amount);
+				break;
+			}
+			max_results *= 2;
+		}
+		batch.packet_candidates[packet + 1] = batch.candidates.size();
+	}
+
+	// Waiting for a group task blocks a pool thread without running other tasks, so when called from a task (such as
+	// AI jobs), the rays are tested on the calling thread. Such callers are already spread over the pool anyway.
+	if (packet_count == 1 || WorkerThreadPool::get_singleton()->get_thread_index() != -1) {
+		for (uint32_t packet = 0; packet < packet_count; packet++) {
+			_intersect_ray_packet(packet, &batch);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_packet, &batch, packet_count, -1, true, SNAME("Physics3DRayBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
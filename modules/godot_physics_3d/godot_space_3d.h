@@ -41,11 +41,37 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	enum {
+		RAY_BATCH_PACKET_SIZE = 16
+	};
+
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		const uint32_t *collision_masks = nullptr;
+		int count = 0;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+
+		// Ray indices sorted by origin, packet `i` owning the rays from `order[packet_rays[i]]` to `order[packet_rays[i + 1]]`.
+		LocalVector<uint32_t> order;
+		LocalVector<uint32_t> packet_rays;
+
+		// Broad phase results of all packets, packet `i` owning those from `packet_candidates[i]` to `packet_candidates[i + 1]`.
+		LocalVector<GodotCollisionObject3D *> candidates;
+		LocalVector<int> candidate_shapes;
+		LocalVector<uint32_t> packet_candidates;
+	};
+
+	void _intersect_ray_packet(uint32_t p_packet, RayBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, const uint32_t *p_collision_masks, int p_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  test_godot_physics_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_collision_solver_3d.h"
+#include "../godot_collision_solver_3d_sat.h"
+#include "../godot_shape_3d.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysics3D {
+
+static Transform3D random_transform(RandomPCG &p_rng, real_t p_max_offset) {
+	const Vector3 euler(p_rng.random(-Math::PI, Math::PI), p_rng.random(-Math::PI, Math::PI), p_rng.random(-Math::PI, Math::PI));
+	const Vector3 origin(p_rng.random(-p_max_offset, p_max_offset), p_rng.random(-p_max_offset, p_max_offset), p_rng.random(-p_max_offset, p_max_offset));
+	return Transform3D(Basis::from_euler(euler), origin);
+}
+
+// A box and a small convex hull, and random placements for pairs of them, most of which overlap.
+struct ShapePairs {
+	GodotBoxShape3D box;
+	GodotConvexPolygonShape3D convex;
+	LocalVector<Transform3D> transforms_A;
+	LocalVector<Transform3D> transforms_B;
+
+	ShapePairs(int p_count) {
+		box.set_data(Vector3(0.5, 0.5, 0.5));
+
+		// A cube with a pyramid on each face.
+		Vector<Vector3> points;
+		for (int i = 0; i < 8; i++) {
+			points.push_back(Vector3(i & 1 ? 0.4 : -0.4, i & 2 ? 0.4 : -0.4, i & 4 ? 0.4 : -0.4));
+		}
+		for (int i = 0; i < 3; i++) {
+			Vector3 apex;
+			apex[i] = 0.6;
+			points.push_back(apex);
+			points.push_back(-apex);
+		}
+		convex.set_data(points);
+
+		RandomPCG rng(1234);
+		for (int i = 0; i < p_count; i++) {
+			transforms_A.push_back(random_transform(rng, 0.0));
+			transforms_B.push_back(random_transform(rng, 1.0));
+		}
+	}
+};
+
+struct SolveStaticResult {
+	bool collided = false;
+	Vector3 separation_axis;
+	LocalVector<Vector3> points;
+};
+
+static void add_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+	SolveStaticResult *result = static_cast<SolveStaticResult *>(p_userdata);
+	result->points.push_back(p_point_A);
+	result->points.push_back(p_point_B);
+}
+
+static void count_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+	(*static_cast<uint64_t *>(p_userdata))++;
+}
+
+static SolveStaticResult solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B) {
+	SolveStaticResult result;
+	result.collided = GodotCollisionSolver3D::solve_static(p_shape_A, p_transform_A, p_shape_B, p_transform_B, &add_contact, &result, &result.separation_axis);
+	return result;
+}
+
+// The batched kernels give the same projections as project_range(), so the results must match exactly.
+static bool are_results_equal(const SolveStaticResult &p_a, const SolveStaticResult &p_b) {
+	if (p_a.collided != p_b.collided || p_a.points.size() != p_b.points.size() || p_a.separation_axis != p_b.separation_axis) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_a.points.size(); i++) {
+		if (p_a.points[i] != p_b.points[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[GodotPhysics3D] Batched axis projection finds the same contacts as projecting one axis at a time") {
+	ShapePairs pairs(500);
+	const GodotShape3D *shape_pairs[][2] = {
+		{ &pairs.box, &pairs.box },
+		{ &pairs.box, &pairs.convex },
+		{ &pairs.convex, &pairs.box },
+		{ &pairs.convex, &pairs.convex },
+	};
+
+	int collisions = 0;
+	int mismatches = 0;
+	for (const auto &shapes : shape_pairs) {
+		for (uint32_t i = 0; i < pairs.transforms_A.size(); i++) {
+			sat_set_batched_axis_projection(true);
+			const SolveStaticResult batched = solve_static(shapes[0], pairs.transforms_A[i], shapes[1], pairs.transforms_B[i]);
+			sat_set_batched_axis_projection(false);
+			const SolveStaticResult scalar = solve_static(shapes[0], pairs.transforms_A[i], shapes[1], pairs.transforms_B[i]);
+
+			collisions += batched.collided ? 1 : 0;
+			mismatches += are_results_equal(batched, scalar) ? 0 : 1;
+		}
+	}
+	sat_set_batched_axis_projection(true);
+
+	CHECK_MESSAGE(collisions > 0, "Some of the pairs should overlap.");
+	CHECK_MESSAGE(mismatches == 0, "Both ways of projecting the axes should give the same contacts.");
+}
+
+TEST_CASE("[GodotPhysics3D][Benchmark] Box and convex pairs with batched and scalar axis projection" * doctest::skip()) {
+	ShapePairs pairs(10000);
+	const struct {
+		const char *name;
+		const GodotShape3D *shape_A;
+		const GodotShape3D *shape_B;
+	} cases[] = {
+		{ "Box and box", &pairs.box, &pairs.box },
+		{ "Box and convex", &pairs.box, &pairs.convex },
+		{ "Convex and convex", &pairs.convex, &pairs.convex },
+	};
+
+	for (const auto &benchmark : cases) {
+		for (int pass = 0; pass < 2; pass++) {
+			const bool batched = pass == 1;
+			sat_set_batched_axis_projection(batched);
+			uint64_t contacts = 0;
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int repeat = 0; repeat < 10; repeat++) {
+				for (uint32_t i = 0; i < pairs.transforms_A.size(); i++) {
+					GodotCollisionSolver3D::solve_static(benchmark.shape_A, pairs.transforms_A[i], benchmark.shape_B, pairs.transforms_B[i], &count_contact, &contacts);
+				}
+			}
+			const uint64_t end = OS::get_singleton()->get_ticks_usec();
+			print_line(vformat("%s (%s): %d usec, %d contacts", benchmark.name, batched ? "batched" : "scalar", end - begin, contacts));
+		}
+	}
+	sat_set_batched_axis_projection(true);
+}
+
+} // namespace TestGodotPhysics3D
@@ -44,6 +44,8 @@
 #include "jolt_query_filter_3d.h"
 #include "jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include "Jolt/Geometry/GJKClosestPoint.h"
 #include "Jolt/Physics/Body/Body.h"
 #include "Jolt/Physics/Body/BodyFilter.h"
@@ -461,15 +463,11 @@ JoltPhysicsDirectSpaceState3D::JoltPhysicsDirectSpaceState3D(JoltSpace3D *p_spac
 		space(p_space) {
 }
 
-bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
-
-	space->flush_pending_objects();
-
-	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+bool JoltPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, uint32_t p_collision_mask, RayResult &r_result) {
+	const JoltQueryFilter3D query_filter(*this, p_collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
 
-	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
-	const JPH::RVec3 to = to_jolt_r(p_parameters.to);
+	const JPH::RVec3 from = to_jolt_r(p_from);
+	const JPH::RVec3 to = to_jolt_r(p_to);
 	const JPH::Vec3 vector = JPH::Vec3(to - from);
 	const JPH::RRayCast ray(from, vector);
 
@@ -524,6 +522,63 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	return true;
 }
 
+void JoltPhysicsDirectSpaceState3D::_intersect_ray_batch_task(uint32_t p_task, RayBatch *p_batch) {
+	const int begin = p_task * RAY_BATCH_TASK_SIZE;
+	const int end = MIN(begin + RAY_BATCH_TASK_SIZE, p_batch->count);
+	for (int i = begin; i < end; i++) {
+		const uint32_t collision_mask = p_batch->collision_masks ? p_batch->collision_masks[i] : p_batch->parameters->collision_mask;
+		p_batch->hits[i] = _intersect_ray(*p_batch->parameters, p_batch->from[i], p_batch->to[i], collision_mask, p_batch->results[i]);
+	}
+}
+
+bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
+
+	space->flush_pending_objects();
+
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, p_parameters.collision_mask, r_result);
+}
+
+int JoltPhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, const uint32_t *p_collision_masks, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), 0, "intersect_ray_batch must not be called while the physics space is being stepped.");
+
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	space->flush_pending_objects();
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.collision_masks = p_collision_masks;
+	batch.count = p_count;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	// Jolt queries don't modify the space, so once the pending objects are flushed the rays can be cast concurrently.
+	// Waiting for a group task blocks a pool thread without running other tasks, so when called from a task (such as
+	// AI jobs), the rays are cast on the calling thread. Such callers are already spread over the pool anyway.
+	const uint32_t task_count = (p_count + RAY_BATCH_TASK_SIZE - 1) / RAY_BATCH_TASK_SIZE;
+	if (task_count == 1 || WorkerThreadPool::get_singleton()->get_thread_index() != -1) {
+		for (uint32_t task = 0; task < task_count; task++) {
+			_intersect_ray_batch_task(task, &batch);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_intersect_ray_batch_task, &batch, task_count, -1, true, SNAME("JoltRayBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	int hit_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_point must not be called while the physics space is being stepped.");
 
@@ -31,6 +31,7 @@
 #include "cpu_particles_3d.h"
 #include "cpu_particles_3d.compat.inc"
 
+#include "core/math/packed_math.h"
 #include "core/math/random_number_generator.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
@@ -86,6 +87,7 @@ void CPUParticles3D::set_amount(int p_amount) {
 	RS::get_singleton()->multimesh_allocate_data(multimesh, p_amount, RS::MULTIMESH_TRANSFORM_3D, true, true);
 
 	particle_order.resize(p_amount);
+	particle_depth.resize(p_amount);
 }
 
 void CPUParticles3D::set_lifetime(double p_lifetime) {
@@ -1265,9 +1267,12 @@ void CPUParticles3D::_update_particle_data_buffer() {
 					dir = dir.normalized();
 				}
 
+				// Compute every depth once up front rather than twice per comparison.
+				real_t *depths = particle_depth.ptrw();
+				PackedMath::dot(&r->transform.origin, dir, depths, pc, sizeof(Particle));
+
 				SortArray<int, SortAxis> sorter;
-				sorter.compare.particles = r;
-				sorter.compare.axis = dir;
+				sorter.compare.depths = depths;
 				sorter.sort(order, pc);
 			}
 		}
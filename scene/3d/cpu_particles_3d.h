@@ -113,6 +113,7 @@ private:
 	Vector<Particle> particles;
 	Vector<float> particle_data;
 	Vector<int> particle_order;
+	Vector<real_t> particle_depth;
 
 	struct SortLifetime {
 		const Particle *particles = nullptr;
@@ -123,10 +124,9 @@ private:
 	};
 
 	struct SortAxis {
-		const Particle *particles = nullptr;
-		Vector3 axis;
+		const real_t *depths = nullptr;
 		bool operator()(int p_a, int p_b) const {
-			return axis.dot(particles[p_a].transform.origin) < axis.dot(particles[p_b].transform.origin);
+			return depths[p_a] < depths[p_b];
 		}
 	};
 
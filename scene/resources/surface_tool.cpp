@@ -30,6 +30,7 @@
 
 #include "surface_tool.h"
 
+#include "core/math/packed_math.h"
 #include "core/templates/a_hash_map.h"
 
 #define EQ_VERTEX_DIST 0.00001
@@ -1039,16 +1040,20 @@ void SurfaceTool::append_from(const Ref<Mesh> &p_existing, int p_surface, const
 	}
 	int vfrom = vertex_array.size();
 
-	for (Vertex &v : nvertices) {
-		v.vertex = p_xform.xform(v.vertex);
+	if (!nvertices.is_empty()) {
+		Vertex *w = nvertices.ptr();
+		const int64_t count = nvertices.size();
+		PackedMath::transform_points(p_xform, &w->vertex, &w->vertex, count, sizeof(Vertex), sizeof(Vertex));
 		if (nformat & RS::ARRAY_FORMAT_NORMAL) {
-			v.normal = p_xform.basis.xform(v.normal);
+			PackedMath::transform_vectors(p_xform.basis, &w->normal, &w->normal, count, sizeof(Vertex), sizeof(Vertex));
 		}
 		if (nformat & RS::ARRAY_FORMAT_TANGENT) {
-			v.tangent = p_xform.basis.xform(v.tangent);
-			v.binormal = p_xform.basis.xform(v.binormal);
+			PackedMath::transform_vectors(p_xform.basis, &w->tangent, &w->tangent, count, sizeof(Vertex), sizeof(Vertex));
+			PackedMath::transform_vectors(p_xform.basis, &w->binormal, &w->binormal, count, sizeof(Vertex), sizeof(Vertex));
 		}
+	}
 
+	for (const Vertex &v : nvertices) {
 		vertex_array.push_back(v);
 	}
 
@@ -1297,16 +1302,7 @@ void SurfaceTool::optimize_indices_for_cache() {
 AABB SurfaceTool::get_aabb() const {
 	ERR_FAIL_COND_V(vertex_array.is_empty(), AABB());
 
-	AABB aabb;
-	for (uint32_t i = 0; i < vertex_array.size(); i++) {
-		if (i == 0) {
-			aabb.position = vertex_array[i].vertex;
-		} else {
-			aabb.expand_to(vertex_array[i].vertex);
-		}
-	}
-
-	return aabb;
+	return PackedMath::compute_aabb(&vertex_array[0].vertex, vertex_array.size(), sizeof(Vertex));
 }
 Vector<int> SurfaceTool::generate_lod(float p_threshold, int p_target_index_count) {
 	WARN_DEPRECATED_MSG(R"*(The "SurfaceTool.generate_lod()" method is deprecated. Consider using "ImporterMesh.generate_lods()" instead.)*");
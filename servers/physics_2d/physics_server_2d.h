@@ -279,6 +279,11 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) = 0;
 
+	virtual void space_set_deterministic(RID p_space, bool p_enable) = 0;
+	virtual bool space_is_deterministic(RID p_space) const = 0;
+	virtual PackedByteArray space_save_state(RID p_space) const = 0;
+	virtual Error space_restore_state(RID p_space, const PackedByteArray &p_state) = 0;
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) = 0;
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
@@ -160,6 +160,11 @@ public:
 
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override { return space_state_dummy; }
 
+	virtual void space_set_deterministic(RID p_space, bool p_enable) override {}
+	virtual bool space_is_deterministic(RID p_space) const override { return false; }
+	virtual PackedByteArray space_save_state(RID p_space) const override { return PackedByteArray(); }
+	virtual Error space_restore_state(RID p_space, const PackedByteArray &p_state) override { return ERR_UNAVAILABLE; }
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override {}
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override { return Vector<Vector2>(); }
 	virtual int space_get_contact_count(RID p_space) const override { return 0; }
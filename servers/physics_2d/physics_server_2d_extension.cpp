@@ -163,6 +163,11 @@ void PhysicsServer2DExtension::_bind_methods() {
 
 	GDVIRTUAL_BIND(_space_get_direct_state, "space");
 
+	GDVIRTUAL_BIND(_space_set_deterministic, "space", "enable");
+	GDVIRTUAL_BIND(_space_is_deterministic, "space");
+	GDVIRTUAL_BIND(_space_save_state, "space");
+	GDVIRTUAL_BIND(_space_restore_state, "space", "state");
+
 	GDVIRTUAL_BIND(_space_set_debug_contacts, "space", "max_contacts");
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
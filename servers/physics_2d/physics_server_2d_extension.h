@@ -237,6 +237,11 @@ public:
 
 	EXBIND1R(PhysicsDirectSpaceState2D *, space_get_direct_state, RID)
 
+	EXBIND2(space_set_deterministic, RID, bool)
+	EXBIND1RC(bool, space_is_deterministic, RID)
+	EXBIND1RC(PackedByteArray, space_save_state, RID)
+	EXBIND2R(Error, space_restore_state, RID, const PackedByteArray &)
+
 	EXBIND2(space_set_debug_contacts, RID, int)
 	EXBIND1RC(Vector<Vector2>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
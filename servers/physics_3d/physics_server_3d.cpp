@@ -382,6 +382,58 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryPa
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_ray_batch(const PackedVector3Array &p_from, const PackedVector3Array &p_to, const PackedInt32Array &p_collision_masks, const Ref<PhysicsRayQueryParameters3D> &p_ray_query) {
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The ray origins and ends must have the same size.");
+	ERR_FAIL_COND_V_MSG(!p_collision_masks.is_empty() && p_collision_masks.size() != p_from.size(), Dictionary(), "The collision masks must be empty or have one mask per ray.");
+
+	RayParameters parameters;
+	if (p_ray_query.is_valid()) {
+		parameters = p_ray_query->get_parameters();
+	}
+
+	const int count = p_from.size();
+	LocalVector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+	const uint32_t *collision_masks = p_collision_masks.is_empty() ? nullptr : reinterpret_cast<const uint32_t *>(p_collision_masks.ptr());
+	intersect_ray_batch(parameters, p_from.ptr(), p_to.ptr(), collision_masks, count, results.ptr(), hits.ptr());
+
+	PackedVector3Array positions;
+	positions.resize(count);
+	PackedVector3Array normals;
+	normals.resize(count);
+	PackedInt64Array rids;
+	rids.resize(count);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	PackedInt32Array face_indices;
+	face_indices.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		const RayResult &result = results[i];
+		const bool hit = hits[i];
+		positions.set(i, hit ? result.position : Vector3());
+		normals.set(i, hit ? result.normal : Vector3());
+		rids.set(i, hit ? (int64_t)result.rid.get_id() : 0);
+		collider_ids.set(i, hit ? (int64_t)result.collider_id : 0);
+		shapes.set(i, hit ? result.shape : -1);
+		face_indices.set(i, hit ? result.face_index : -1);
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["rid"] = rids;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["face_index"] = face_indices;
+
+	return d;
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results) {
 	ERR_FAIL_COND_V(p_point_query.is_null(), TypedArray<Dictionary>());
 
@@ -481,12 +533,32 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+int PhysicsDirectSpaceState3D::intersect_ray_batch(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, const uint32_t *p_collision_masks, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	int hit_count = 0;
+
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		if (p_collision_masks) {
+			parameters.collision_mask = p_collision_masks[i];
+		}
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_ray_batch", "from", "to", "collision_masks", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray_batch, DEFVAL(PackedInt32Array()), DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
@@ -81,6 +81,8 @@ void PhysicsServer3DWrapMT::end_sync() {
 
 	if (create_thread) {
 		doing_sync.clear();
+		// The server thread doesn't flush while syncing, so wake it up for anything pushed meanwhile.
+		command_queue.notify_pump_if_pending();
 	}
 }
 
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct PairingItem {
+	int id = 0;
+};
+
+template <typename T>
+class PairingTestFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+template <typename T>
+class PairingCullTestFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+// Same layout as the 3D physics broad phase: static items in tree 0, moving items in tree 1.
+typedef BVH_Manager<PairingItem, 2, true, 128, PairingTestFunction<PairingItem>, PairingCullTestFunction<PairingItem>> PairingBVH;
+
+// Pairs are stored as positive ids, unpairs as negative ones.
+struct PairingEvent {
+	int item_A = 0;
+	int item_B = 0;
+
+	bool operator==(const PairingEvent &p_other) const { return item_A == p_other.item_A && item_B == p_other.item_B; }
+};
+
+static void *pair_callback(void *p_userdata, uint32_t p_id_A, PairingItem *p_item_A, int p_subindex_A, uint32_t p_id_B, PairingItem *p_item_B, int p_subindex_B) {
+	static_cast<LocalVector<PairingEvent> *>(p_userdata)->push_back({ p_item_A->id, p_item_B->id });
+	return nullptr;
+}
+
+static void unpair_callback(void *p_userdata, uint32_t p_id_A, PairingItem *p_item_A, int p_subindex_A, uint32_t p_id_B, PairingItem *p_item_B, int p_subindex_B, void *p_pair_data) {
+	static_cast<LocalVector<PairingEvent> *>(p_userdata)->push_back({ -p_item_A->id, -p_item_B->id });
+}
+
+static AABB random_item_aabb(RandomPCG &p_rng) {
+	const Vector3 position(p_rng.random(-10.0f, 10.0f), p_rng.random(-10.0f, 10.0f), p_rng.random(-10.0f, 10.0f));
+	return AABB(position, Vector3(p_rng.random(0.5f, 1.5f), p_rng.random(0.5f, 1.5f), p_rng.random(0.5f, 1.5f)));
+}
+
+// Moves every moving item each step, so each update checks twice the changed items
+// the parallel check needs (`PARALLEL_COLLISION_CHECK_MIN_ITEMS`).
+static LocalVector<PairingEvent> run_pairing_steps(bool p_parallel) {
+	const uint32_t static_count = 100;
+	const uint32_t moving_count = 512;
+
+	LocalVector<PairingEvent> events;
+	LocalVector<PairingItem> items;
+	items.resize(static_count + moving_count);
+	LocalVector<BVHHandle> handles;
+
+	PairingBVH bvh;
+	bvh.set_pair_callback(&pair_callback, &events);
+	bvh.set_unpair_callback(&unpair_callback, &events);
+	bvh.params_set_parallel_collision_check(p_parallel);
+
+	RandomPCG rng(4321);
+	for (uint32_t i = 0; i < items.size(); i++) {
+		items[i].id = i + 1;
+		const bool is_static = i < static_count;
+		handles.push_back(bvh.create(&items[i], true, is_static ? 0 : 1, is_static ? 2 : 3, random_item_aabb(rng)));
+	}
+
+	for (int step = 0; step < 10; step++) {
+		for (uint32_t i = static_count; i < items.size(); i++) {
+			bvh.move(handles[i], random_item_aabb(rng));
+		}
+		bvh.update();
+	}
+
+	for (const BVHHandle &handle : handles) {
+		bvh.erase(handle);
+	}
+	return events;
+}
+
+TEST_CASE("[BVH] Parallel collision check sends the same pair callbacks as the serial one") {
+	const LocalVector<PairingEvent> serial = run_pairing_steps(false);
+	const LocalVector<PairingEvent> parallel = run_pairing_steps(true);
+
+	int pairs = 0;
+	int unpairs = 0;
+	for (const PairingEvent &event : serial) {
+		pairs += event.item_A > 0 ? 1 : 0;
+		unpairs += event.item_A < 0 ? 1 : 0;
+	}
+	CHECK_MESSAGE(pairs > 0, "Some of the items should overlap.");
+	CHECK_MESSAGE(unpairs > 0, "Some of the pairs should separate again.");
+
+	REQUIRE(serial.size() == parallel.size());
+	int mismatches = 0;
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		mismatches += serial[i] == parallel[i] ? 0 : 1;
+	}
+	CHECK_MESSAGE(mismatches == 0, "Pairs and unpairs should be sent in the same order.");
+}
+
+} // namespace TestBVH
@@ -249,6 +249,14 @@ TEST_CASE("[Expression] Built-in functions") {
 	CHECK_MESSAGE(
 			Math::is_zero_approx(double(expression.execute())),
 			"`pow(2.0, -2500)` should return the expected result (asymptotically zero).");
+
+	// More arguments than are stored inline while evaluating.
+	CHECK_MESSAGE(
+			expression.parse("remap(5, 0, 10, 0, 100)") == OK,
+			"The expression should parse successfully.");
+	CHECK_MESSAGE(
+			double(expression.execute()) == doctest::Approx(50.0),
+			"`remap(5, 0, 10, 0, 100)` should return the expected result.");
 }
 
 TEST_CASE("[Expression] Boolean expressions") {
@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  test_packed_math.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/packed_math.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedMath {
+
+// The kernels must give the same bits as the scalar math, including the sign of zeros.
+static bool _is_bit_identical(const Vector3 &p_a, const Vector3 &p_b) {
+	return memcmp(&p_a, &p_b, sizeof(Vector3)) == 0;
+}
+
+TEST_CASE("[PackedMath] Transform points and vectors") {
+	const Transform3D xform = Transform3D(Basis(Vector3(0, 1, 0), Math::PI / 3.0).scaled(Vector3(1, 2, 3)), Vector3(4, -5, 6));
+
+	// Odd size so the tail of any vectorized loop is exercised. Values that aren't exact in binary
+	// make any change in the order of operations show up in the last bits.
+	LocalVector<Vector3> points;
+	for (int i = 0; i < 7; i++) {
+		points.push_back(Vector3(i * 0.1, -2 * i / 3.0, 0.7 * i + 1e-3));
+	}
+	points.push_back(Vector3(-0.0, 0.0, -0.0));
+
+	LocalVector<Vector3> transformed;
+	transformed.resize(points.size());
+	PackedMath::transform_points(xform, points.ptr(), transformed.ptr(), points.size());
+	for (uint32_t i = 0; i < points.size(); i++) {
+		CHECK(_is_bit_identical(transformed[i], xform.xform(points[i])));
+	}
+
+	PackedMath::inverse_transform_points(xform, points.ptr(), transformed.ptr(), points.size());
+	for (uint32_t i = 0; i < points.size(); i++) {
+		CHECK(_is_bit_identical(transformed[i], xform.xform_inv(points[i])));
+	}
+
+	PackedMath::transform_vectors(xform.basis, points.ptr(), transformed.ptr(), points.size());
+	for (uint32_t i = 0; i < points.size(); i++) {
+		CHECK(_is_bit_identical(transformed[i], xform.basis.xform(points[i])));
+	}
+
+	// In place.
+	LocalVector<Vector3> in_place = points;
+	PackedMath::transform_points(xform, in_place.ptr(), in_place.ptr(), in_place.size());
+	for (uint32_t i = 0; i < points.size(); i++) {
+		CHECK(_is_bit_identical(in_place[i], xform.xform(points[i])));
+	}
+}
+
+TEST_CASE("[PackedMath] Strided access") {
+	struct Vertex {
+		Vector3 normal;
+		int flags = 0;
+		Vector3 vertex;
+	};
+
+	const Transform3D xform = Transform3D(Basis(), Vector3(1, 2, 3));
+	Vertex vertices[3];
+	for (int i = 0; i < 3; i++) {
+		vertices[i].normal = Vector3(0, 1, 0);
+		vertices[i].flags = i;
+		vertices[i].vertex = Vector3(i, i, i);
+	}
+
+	PackedMath::transform_points(xform, &vertices[0].vertex, &vertices[0].vertex, 3, sizeof(Vertex), sizeof(Vertex));
+	for (int i = 0; i < 3; i++) {
+		CHECK(vertices[i].vertex.is_equal_approx(Vector3(i + 1, i + 2, i + 3)));
+		CHECK_MESSAGE(vertices[i].flags == i, "Members between strided elements should not be modified.");
+		CHECK(vertices[i].normal == Vector3(0, 1, 0));
+	}
+
+	const AABB aabb = PackedMath::compute_aabb(&vertices[0].vertex, 3, sizeof(Vertex));
+	CHECK(aabb.is_equal_approx(AABB(Vector3(1, 2, 3), Vector3(2, 2, 2))));
+}
+
+TEST_CASE("[PackedMath] AABB and dot") {
+	const Vector3 points[] = { Vector3(1, -1, 0), Vector3(-3, 2, 5), Vector3(0, 0, -2) };
+
+	CHECK(PackedMath::compute_aabb(points, 3).is_equal_approx(AABB(Vector3(-3, -1, -2), Vector3(4, 3, 7))));
+	CHECK(PackedMath::compute_aabb(points, 0) == AABB());
+
+	real_t dots[3];
+	PackedMath::dot(points, Vector3(1, 2, 3), dots, 3);
+	CHECK(dots[0] == doctest::Approx(-1.0));
+	CHECK(dots[1] == doctest::Approx(16.0));
+	CHECK(dots[2] == doctest::Approx(-6.0));
+}
+
+TEST_CASE("[PackedMath] Float kernels") {
+	const float a[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	const float b[] = { 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+
+	float lerped[9];
+	PackedMath::lerp(a, b, 0.25f, lerped, 9);
+	for (int i = 0; i < 9; i++) {
+		CHECK(lerped[i] == doctest::Approx(Math::lerp(a[i], b[i], 0.25f)));
+	}
+
+	CHECK(PackedMath::dot(a, b, 9) == doctest::Approx(165.0));
+	CHECK(PackedMath::dot(a, b, 0) == doctest::Approx(0.0));
+
+	const float values[] = { 3, -7, 2, 11, 0, 5, -1 };
+	float min = 0.0f;
+	float max = 0.0f;
+	CHECK(PackedMath::min_max(values, 7, min, max));
+	CHECK(min == doctest::Approx(-7.0));
+	CHECK(max == doctest::Approx(11.0));
+
+	min = 42.0f;
+	CHECK_FALSE(PackedMath::min_max(values, 0, min, max));
+	CHECK_MESSAGE(min == 42.0f, "Outputs should be left untouched for an empty array.");
+}
+
+TEST_CASE("[PackedMath] Transform3D array xform") {
+	const Transform3D xform = Transform3D(Basis(Vector3(1, 0, 0), 0.5), Vector3(-2, 3, 1));
+	Vector<Vector3> points = { Vector3(1, 2, 3), Vector3(-4, 0, 2), Vector3(0, 0, 0), Vector3(7, -1, 0.5), Vector3(1, 1, 1) };
+
+	const Vector<Vector3> transformed = xform.xform(points);
+	const Vector<Vector3> inverse = xform.xform_inv(points);
+	REQUIRE(transformed.size() == points.size());
+	REQUIRE(inverse.size() == points.size());
+	for (int i = 0; i < points.size(); i++) {
+		CHECK(_is_bit_identical(transformed[i], xform.xform(points[i])));
+		CHECK(_is_bit_identical(inverse[i], xform.xform_inv(points[i])));
+	}
+}
+
+TEST_CASE("[PackedMath] PackedFloat32Array min and max") {
+	Variant array = PackedFloat32Array({ 3, -7, 2, 11, 0 });
+	Callable::CallError error;
+	Variant result;
+	array.callp("min", nullptr, 0, result, error);
+	CHECK(result == Variant(-7.0));
+	array.callp("max", nullptr, 0, result, error);
+	CHECK(result == Variant(11.0));
+
+	// Like Array, there is no minimum or maximum of an empty array.
+	Variant empty = PackedFloat32Array();
+	empty.callp("min", nullptr, 0, result, error);
+	CHECK(result.get_type() == Variant::NIL);
+	empty.callp("max", nullptr, 0, result, error);
+	CHECK(result.get_type() == Variant::NIL);
+}
+
+} // namespace TestPackedMath
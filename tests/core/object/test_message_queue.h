@@ -0,0 +1,245 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/callable_method_pointer.h"
+#include "core/object/message_queue.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class ThreadedCallQueue : public CallQueue {
+public:
+	ThreadedCallQueue(uint32_t p_max_pages = 8192) :
+			CallQueue(nullptr, p_max_pages) {
+		set_thread_pages_enabled(true);
+	}
+};
+
+static LocalVector<int> call_order;
+
+static void record_call(int p_value) {
+	call_order.push_back(p_value);
+}
+
+struct PushFromThread {
+	CallQueue *queue = nullptr;
+	int first = 0;
+	int count = 0;
+
+	static void push(void *p_userdata) {
+		PushFromThread *data = static_cast<PushFromThread *>(p_userdata);
+		for (int i = 0; i < data->count; i++) {
+			data->queue->push_callable(callable_mp_static(&record_call), data->first + i);
+		}
+	}
+};
+
+TEST_CASE("[MessageQueue] Calls from all threads run in the order they were pushed") {
+	ThreadedCallQueue queue;
+	call_order.clear();
+
+	queue.push_callable(callable_mp_static(&record_call), 0);
+
+	PushFromThread data;
+	data.queue = &queue;
+	data.first = 100;
+	data.count = 3;
+	Thread thread;
+	thread.start(&PushFromThread::push, &data);
+	thread.wait_to_finish();
+
+	CHECK(queue.has_messages());
+
+	queue.push_callable(callable_mp_static(&record_call), 1);
+
+	data.first = 200;
+	data.count = 1;
+	thread.start(&PushFromThread::push, &data);
+	thread.wait_to_finish();
+
+	queue.push_callable(callable_mp_static(&record_call), 2);
+	queue.flush();
+
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(call_order.size() == 7);
+	CHECK(call_order[0] == 0);
+	CHECK(call_order[1] == 100);
+	CHECK(call_order[2] == 101);
+	CHECK(call_order[3] == 102);
+	CHECK(call_order[4] == 1);
+	CHECK(call_order[5] == 200);
+	CHECK(call_order[6] == 2);
+}
+
+TEST_CASE("[MessageQueue] Calls from other threads spanning several pages") {
+	ThreadedCallQueue queue;
+	call_order.clear();
+
+	// Enough messages to need several pages.
+	const int count = 4 * CallQueue::PAGE_SIZE_BYTES / (sizeof(Callable) + sizeof(Variant));
+	PushFromThread data;
+	data.queue = &queue;
+	data.count = count;
+	Thread thread;
+	thread.start(&PushFromThread::push, &data);
+	thread.wait_to_finish();
+
+	queue.flush();
+
+	REQUIRE(call_order.size() == uint32_t(count));
+	bool in_order = true;
+	for (int i = 0; i < count; i++) {
+		in_order = in_order && call_order[i] == i;
+	}
+	CHECK_MESSAGE(in_order, "Calls from a thread should keep the order they were pushed in.");
+
+	// Pages are reused by the next pushes.
+	call_order.clear();
+	thread.start(&PushFromThread::push, &data);
+	thread.wait_to_finish();
+	queue.clear();
+	queue.flush();
+	CHECK(call_order.is_empty());
+}
+
+TEST_CASE("[MessageQueue] Pages of threads that stopped pushing are given back") {
+	ThreadedCallQueue queue;
+	call_order.clear();
+
+	const int thread_count = 10;
+	PushFromThread data;
+	data.queue = &queue;
+	data.count = 1;
+	for (int i = 0; i < thread_count; i++) {
+		Thread thread;
+		thread.start(&PushFromThread::push, &data);
+		thread.wait_to_finish();
+	}
+	queue.flush();
+	CHECK(call_order.size() == thread_count);
+
+	// Each thread kept at least a spare page.
+	int usage = queue.get_max_buffer_usage();
+	for (int i = 0; i < 32; i++) {
+		queue.flush();
+	}
+	CHECK(queue.get_max_buffer_usage() <= usage - thread_count * CallQueue::PAGE_SIZE_BYTES);
+
+	// New threads can still push.
+	call_order.clear();
+	data.first = 100;
+	Thread thread;
+	thread.start(&PushFromThread::push, &data);
+	thread.wait_to_finish();
+	queue.flush();
+	REQUIRE(call_order.size() == 1);
+	CHECK(call_order[0] == 100);
+}
+
+struct PushUntilFull {
+	CallQueue *queue = nullptr;
+	int pushed = 0;
+
+	static void push(void *p_userdata) {
+		PushUntilFull *data = static_cast<PushUntilFull *>(p_userdata);
+		while (data->queue->push_callable(callable_mp_static(&record_call), data->pushed) == OK) {
+			data->pushed++;
+		}
+	}
+};
+
+TEST_CASE("[MessageQueue] Pages of all threads count toward the same limit") {
+	ThreadedCallQueue queue(2);
+	call_order.clear();
+
+	PushUntilFull data;
+	data.queue = &queue;
+	Thread thread;
+	thread.start(&PushUntilFull::push, &data);
+	thread.wait_to_finish();
+	CHECK(data.pushed > 0);
+
+	// The other thread used up all the pages.
+	CHECK(queue.push_callable(callable_mp_static(&record_call), -1) == ERR_OUT_OF_MEMORY);
+
+	queue.flush();
+	CHECK(call_order.size() == uint32_t(data.pushed));
+
+	// Flushing gave the pages back.
+	call_order.clear();
+	CHECK(queue.push_callable(callable_mp_static(&record_call), 0) == OK);
+	queue.flush();
+	REQUIRE(call_order.size() == 1);
+	CHECK(call_order[0] == 0);
+}
+
+struct PushTwiceFromThread {
+	CallQueue *queue = nullptr;
+	Semaphore pushed;
+	Semaphore resume;
+
+	static void push(void *p_userdata) {
+		PushTwiceFromThread *data = static_cast<PushTwiceFromThread *>(p_userdata);
+		data->queue->push_callable(callable_mp_static(&record_call), 1);
+		data->pushed.post();
+		data->resume.wait();
+		data->queue->push_callable(callable_mp_static(&record_call), 2);
+	}
+};
+
+TEST_CASE("[MessageQueue] Threads keep pushing after their pages were given back") {
+	ThreadedCallQueue queue;
+	call_order.clear();
+
+	PushTwiceFromThread data;
+	data.queue = &queue;
+	Thread thread;
+	thread.start(&PushTwiceFromThread::push, &data);
+	data.pushed.wait();
+
+	// Enough flushes for the idle thread to lose its pages while it is still running.
+	for (int i = 0; i < 32; i++) {
+		queue.flush();
+	}
+	data.resume.post();
+	thread.wait_to_finish();
+	queue.flush();
+
+	REQUIRE(call_order.size() == 2);
+	CHECK(call_order[0] == 1);
+	CHECK(call_order[1] == 2);
+}
+
+} // namespace TestMessageQueue
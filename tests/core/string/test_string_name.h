@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName from_c_string = "interned_name";
+	const StringName from_string = String("interned_name");
+
+	CHECK(from_c_string == from_string);
+	CHECK(from_c_string.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(from_c_string.hash() == String("interned_name").hash());
+	CHECK(from_c_string != StringName("other_name"));
+
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+	CHECK(StringName() == StringName(""));
+}
+
+TEST_CASE("[StringName] Release and intern again") {
+	const String name = "released_name";
+	{
+		const StringName first = name;
+		CHECK(first == name);
+	}
+	// The entry is gone with its last reference, so it must be created again, identical to the original.
+	const StringName second = name;
+	const StringName third = name;
+	CHECK(second == name);
+	CHECK(second.data_unique_pointer() == third.data_unique_pointer());
+}
+
+static const int THREAD_NAME_COUNT = 512;
+
+struct InternThreadData {
+	const LocalVector<String> *names = nullptr;
+	int rounds = 0;
+	LocalVector<StringName> result;
+};
+
+static void intern_thread_function(void *p_userdata) {
+	InternThreadData *data = (InternThreadData *)p_userdata;
+	const LocalVector<String> &names = *data->names;
+	LocalVector<StringName> interned;
+	interned.resize(names.size());
+	for (int round = 0; round < data->rounds; round++) {
+		for (uint32_t i = 0; i < names.size(); i++) {
+			interned[i] = names[i];
+		}
+		// Drop the references, so entries get released and interned again concurrently.
+		for (uint32_t i = 0; i < names.size(); i++) {
+			interned[i] = StringName();
+		}
+	}
+	data->result.resize(names.size());
+	for (uint32_t i = 0; i < names.size(); i++) {
+		data->result[i] = names[i];
+	}
+}
+
+TEST_CASE("[StringName] Concurrent interning and release") {
+	const int THREAD_COUNT = 4;
+
+	LocalVector<String> names;
+	for (int i = 0; i < THREAD_NAME_COUNT; i++) {
+		names.push_back(vformat("concurrent_name_%d", i));
+	}
+
+	InternThreadData data[THREAD_COUNT];
+	Thread threads[THREAD_COUNT];
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		data[i].names = &names;
+		data[i].rounds = 50;
+		threads[i].start(intern_thread_function, &data[i]);
+	}
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	bool all_equal = true;
+	for (int i = 0; i < THREAD_NAME_COUNT; i++) {
+		// Reduce number of check messages.
+		all_equal &= data[0].result[i] == names[i];
+		for (int j = 1; j < THREAD_COUNT; j++) {
+			all_equal &= data[j].result[i].data_unique_pointer() == data[0].result[i].data_unique_pointer();
+		}
+	}
+	CHECK(all_equal);
+}
+
+// Every thread interns its own names, so threads only wait on each other when two names land in the same shard.
+TEST_CASE("[StringName][Benchmark] Construction and destruction throughput" * doctest::skip()) {
+	const int ROUNDS = 200;
+
+	const int max_threads = MAX(1, OS::get_singleton()->get_processor_count());
+	for (int thread_count = 1;; thread_count = MIN(thread_count * 2, max_threads)) {
+		// Every thread works on its own set of names, as is the case of unrelated resources being loaded in parallel.
+		LocalVector<LocalVector<String>> names;
+		names.resize(thread_count);
+		LocalVector<InternThreadData> data;
+		data.resize(thread_count);
+		for (int i = 0; i < thread_count; i++) {
+			for (int j = 0; j < THREAD_NAME_COUNT; j++) {
+				names[i].push_back(vformat("benchmark_name_%d_%d", i, j));
+			}
+			data[i].names = &names[i];
+			data[i].rounds = ROUNDS;
+		}
+
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(intern_thread_function, &data[i]);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		const uint64_t usec = MAX((uint64_t)1, OS::get_singleton()->get_ticks_usec() - begin);
+
+		// Each round constructs and destroys every name once.
+		const uint64_t operations = (uint64_t)thread_count * ROUNDS * THREAD_NAME_COUNT;
+		print_line(vformat("%d threads: %d constructions and destructions/s.", thread_count, (int64_t)(operations * 1000000 / usec)));
+
+		if (thread_count == max_threads) {
+			break;
+		}
+	}
+}
+
+} // namespace TestStringName
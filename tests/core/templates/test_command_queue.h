@@ -518,4 +518,196 @@ TEST_CASE("[CommandQueue] Test Parameter Passing Semantics") {
 
 	sts.destroy_threads();
 }
+
+// Records the order commands run in. Large commands don't fit in the ring and go through the mutex instead.
+class CommandOrder {
+public:
+	struct Large {
+		uint8_t data[16 * 1024] = {};
+	};
+
+	static const int PRODUCERS = 4;
+	static const uint64_t COMMANDS_PER_PRODUCER = 20000;
+
+	CommandQueueMT command_queue;
+	uint64_t next[PRODUCERS] = {};
+	int out_of_order = 0;
+	uint64_t processed = 0;
+	bool exit = false;
+
+	void record(int p_producer, uint64_t p_index) {
+		if (p_index != next[p_producer]) {
+			out_of_order++;
+		}
+		next[p_producer] = p_index + 1;
+		processed++;
+	}
+
+	void record_large(int p_producer, uint64_t p_index, const Large &p_large) {
+		record(p_producer, p_index);
+	}
+
+	uint64_t record_and_ret(int p_producer, uint64_t p_index) {
+		record(p_producer, p_index);
+		return p_index;
+	}
+
+#ifdef THREADS_ENABLED
+	static void pump_loop(void *p_userdata) {
+		CommandOrder *order = static_cast<CommandOrder *>(p_userdata);
+		while (!order->exit) {
+			order->command_queue.flush_if_pending();
+			Thread::yield();
+		}
+	}
+
+	// Mixes ring pushes with large commands and calls that wait for a return value.
+	struct Producer {
+		CommandOrder *order = nullptr;
+		int index = 0;
+		int wrong_returns = 0;
+
+		static void run(void *p_userdata) {
+			Producer *producer = static_cast<Producer *>(p_userdata);
+			CommandOrder *order = producer->order;
+			for (uint64_t i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+				if (i % 2000 == 1000) {
+					uint64_t ret = 0;
+					order->command_queue.push_and_ret(order, &CommandOrder::record_and_ret, &ret, producer->index, i);
+					producer->wrong_returns += ret == i ? 0 : 1;
+				} else if (i % 700 == 350) {
+					order->command_queue.push(order, &CommandOrder::record_large, producer->index, i, Large());
+				} else {
+					order->command_queue.push(order, &CommandOrder::record, producer->index, i);
+				}
+			}
+		}
+	};
+#endif // THREADS_ENABLED
+};
+
+TEST_CASE("[CommandQueue] Commands run in push order when the ring is full or bypassed") {
+	CommandOrder order;
+
+	// Enough 48-byte commands to fill the ring several times over, so later ones go through the mutex
+	// until the queue is flushed.
+	const uint64_t count = 10000;
+	for (uint64_t i = 0; i < count; i++) {
+		if (i % 1000 == 500) {
+			order.command_queue.push(&order, &CommandOrder::record_large, 0, i, CommandOrder::Large());
+		} else {
+			order.command_queue.push(&order, &CommandOrder::record, 0, i);
+		}
+	}
+	CHECK_MESSAGE(order.processed == 0, "Nothing should run before the queue is flushed.");
+
+	order.command_queue.flush_all();
+	CHECK(order.processed == count);
+	CHECK_MESSAGE(order.out_of_order == 0, "Commands should run in the order they were pushed in.");
+
+	// The ring must be usable again once the commands that went through the mutex have run.
+	order.command_queue.push(&order, &CommandOrder::record, 0, count);
+	order.command_queue.flush_if_pending();
+	CHECK(order.processed == count + 1);
+	CHECK(order.out_of_order == 0);
+}
+
+#ifdef THREADS_ENABLED
+TEST_CASE("[CommandQueue] Commands from each thread run in push order") {
+	CommandOrder order;
+	Thread pump;
+	pump.start(&CommandOrder::pump_loop, &order);
+
+	CommandOrder::Producer producers[CommandOrder::PRODUCERS];
+	Thread threads[CommandOrder::PRODUCERS];
+	for (int i = 0; i < CommandOrder::PRODUCERS; i++) {
+		producers[i].order = &order;
+		producers[i].index = i;
+		threads[i].start(&CommandOrder::Producer::run, &producers[i]);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	order.command_queue.sync();
+	order.exit = true;
+	pump.wait_to_finish();
+
+	CHECK(order.processed == CommandOrder::COMMANDS_PER_PRODUCER * CommandOrder::PRODUCERS);
+	CHECK_MESSAGE(order.out_of_order == 0, "Commands from the same thread should run in the order they were pushed in.");
+	for (const CommandOrder::Producer &producer : producers) {
+		CHECK(producer.wrong_returns == 0);
+	}
+}
+#endif // THREADS_ENABLED
+
+// Producers push as fast as they can while the pump task keeps yielding and flushing. Pushes go into
+// the ring without the queue mutex, and most of them find the pump already notified.
+class CommandQueueBenchmark {
+public:
+	static const int COMMANDS_PER_PRODUCER = 100000;
+
+	CommandQueueMT command_queue;
+	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	bool exit = false;
+	uint64_t processed = 0;
+
+	void process(Transform3D p_transform) {
+		processed++;
+	}
+
+	void finish() {
+		exit = true;
+	}
+
+	// Same loop as the rendering and physics server threads.
+	static void pump_loop(void *p_userdata) {
+		CommandQueueBenchmark *benchmark = static_cast<CommandQueueBenchmark *>(p_userdata);
+		while (!benchmark->exit) {
+			WorkerThreadPool::get_singleton()->yield();
+			benchmark->command_queue.flush_all();
+		}
+	}
+
+	static void producer_loop(void *p_userdata) {
+		CommandQueueBenchmark *benchmark = static_cast<CommandQueueBenchmark *>(p_userdata);
+		const Transform3D transform;
+		for (int i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+			benchmark->command_queue.push(benchmark, &CommandQueueBenchmark::process, transform);
+		}
+	}
+
+	// Returns the time in microseconds until the pump has processed every command.
+	uint64_t run(int p_producers) {
+		pump_task_id = WorkerThreadPool::get_singleton()->add_native_task(&CommandQueueBenchmark::pump_loop, this, true);
+		command_queue.set_pump_task_id(pump_task_id);
+
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		LocalVector<Thread> producers;
+		producers.resize(p_producers);
+		for (Thread &producer : producers) {
+			producer.start(&CommandQueueBenchmark::producer_loop, this);
+		}
+		for (Thread &producer : producers) {
+			producer.wait_to_finish();
+		}
+		command_queue.sync();
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+		command_queue.push(this, &CommandQueueBenchmark::finish);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id);
+		command_queue.flush_all();
+		return elapsed;
+	}
+};
+
+TEST_CASE("[CommandQueue][Benchmark] Push throughput with a pump task" * doctest::skip()) {
+	for (int producers : { 1, 2, 4, 8 }) {
+		CommandQueueBenchmark benchmark;
+		const uint64_t elapsed = benchmark.run(producers);
+		const uint64_t total = uint64_t(producers) * CommandQueueBenchmark::COMMANDS_PER_PRODUCER;
+		CHECK(benchmark.processed == total);
+		print_line(vformat("%d producer(s): %d commands in %.2f ms, %.2f Mcommands/s.", producers, total, elapsed / 1000.0, double(total) / MAX(elapsed, 1u)));
+	}
+}
 } // namespace TestCommandQueue
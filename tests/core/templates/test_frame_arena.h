@@ -0,0 +1,212 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/templates/frame_arena.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Memory is reused once everything is freed") {
+	REQUIRE(FrameArena::get_thread_live_allocations() == 0);
+
+	void *first = FrameArena::alloc(100);
+	void *second = FrameArena::alloc(200);
+	CHECK(first != second);
+	CHECK(((uintptr_t)first % FrameArena::ALIGNMENT) == 0);
+	CHECK(((uintptr_t)second % FrameArena::ALIGNMENT) == 0);
+	CHECK(FrameArena::get_thread_live_allocations() == 2);
+
+	FrameArena::free(first);
+	FrameArena::free(second);
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+
+	void *again = FrameArena::alloc(100);
+	CHECK(again == first);
+	FrameArena::free(again);
+}
+
+TEST_CASE("[FrameArena] Last allocation grows in place") {
+	void *mem = FrameArena::alloc(64);
+	memset(mem, 0x5A, 64);
+
+	void *grown = FrameArena::realloc(mem, 1024);
+	CHECK(grown == mem);
+	CHECK(((uint8_t *)grown)[63] == 0x5A);
+
+	// Not the last allocation anymore, so it has to be moved.
+	void *other = FrameArena::alloc(16);
+	void *moved = FrameArena::realloc(grown, 2048);
+	CHECK(moved != grown);
+	CHECK(((uint8_t *)moved)[0] == 0x5A);
+	CHECK(((uint8_t *)moved)[63] == 0x5A);
+
+	FrameArena::free(other);
+	FrameArena::free(moved);
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+TEST_CASE("[FrameArena] Allocations bigger than a block") {
+	const size_t size = FrameArena::BLOCK_SIZE * 3;
+	uint8_t *small = (uint8_t *)FrameArena::alloc(32);
+	uint8_t *big = (uint8_t *)FrameArena::alloc(size);
+	big[0] = 1;
+	big[size - 1] = 2;
+	CHECK(big[0] == 1);
+	CHECK(big[size - 1] == 2);
+	FrameArena::free(big);
+	FrameArena::free(small);
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+TEST_CASE("[FrameArena] Blocks are reused in the next frame") {
+	// Several blocks' worth, freed in allocation order so only the last one is given back right away.
+	LocalVector<void *> allocations;
+	for (int i = 0; i < 1000; i++) {
+		allocations.push_back(FrameArena::alloc(256));
+	}
+	for (void *mem : allocations) {
+		FrameArena::free(mem);
+	}
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+
+	FrameArena::advance_frame();
+
+	LocalVector<void *> next_frame_allocations;
+	for (int i = 0; i < 1000; i++) {
+		next_frame_allocations.push_back(FrameArena::alloc(256));
+	}
+	bool all_reused = true;
+	for (int i = 0; i < 1000; i++) {
+		all_reused &= next_frame_allocations[i] == allocations[i];
+	}
+	CHECK_MESSAGE(all_reused, "The same blocks should be used again, from the start.");
+	for (void *mem : next_frame_allocations) {
+		FrameArena::free(mem);
+	}
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[FrameArena] Memory freed after the end of its frame is reported") {
+	const uint32_t escaped_allocations = FrameArena::get_escaped_allocations();
+
+	void *mem = FrameArena::alloc(64);
+	FrameArena::free(mem);
+	CHECK_MESSAGE(FrameArena::get_escaped_allocations() == escaped_allocations, "Memory freed within its frame is fine.");
+
+	mem = FrameArena::alloc(64);
+	FrameArena::advance_frame();
+	ERR_PRINT_OFF;
+	FrameArena::free(mem);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(FrameArena::get_escaped_allocations() == escaped_allocations + 1, "Surviving a single frame boundary is already an escape.");
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+#endif // DEBUG_ENABLED
+
+static void free_from_thread(void *p_userdata) {
+	FrameArena::free(p_userdata);
+}
+
+TEST_CASE("[FrameArena] Free from another thread") {
+	void *mem = FrameArena::alloc(128);
+	CHECK(FrameArena::get_thread_live_allocations() == 1);
+
+	Thread thread;
+	thread.start(free_from_thread, mem);
+	thread.wait_to_finish();
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+static void alloc_from_thread(void *p_userdata) {
+	void **allocations = static_cast<void **>(p_userdata);
+	allocations[0] = FrameArena::alloc(128);
+	// Bigger than a block, so the arena has more than one to free.
+	allocations[1] = FrameArena::alloc(FrameArena::BLOCK_SIZE * 2);
+	memset(allocations[1], 1, FrameArena::BLOCK_SIZE * 2);
+}
+
+TEST_CASE("[FrameArena] Free after the allocating thread has exited") {
+	void *allocations[2] = {};
+	Thread thread;
+	thread.start(alloc_from_thread, allocations);
+	thread.wait_to_finish();
+
+	// The arena of the thread must still be around for these, and goes away with the last one.
+	CHECK(((uint8_t *)allocations[1])[FrameArena::BLOCK_SIZE] == 1);
+	FrameArena::free(allocations[0]);
+	FrameArena::free(allocations[1]);
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+TEST_CASE("[FrameArena] FrameLocalVector") {
+	{
+		FrameLocalVector<int> vector;
+		for (int i = 0; i < 10000; i++) {
+			vector.push_back(i);
+		}
+		CHECK(vector.size() == 10000);
+
+		bool all_equal = true;
+		for (int i = 0; i < 10000; i++) {
+			// Reduce number of check messages.
+			all_equal &= vector[i] == i;
+		}
+		CHECK(all_equal);
+
+		FrameLocalVector<int> moved = std::move(vector);
+		CHECK(vector.is_empty());
+		CHECK(moved.size() == 10000);
+		CHECK(moved[9999] == 9999);
+	}
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+TEST_CASE("[FrameArena] FrameHashMap") {
+	{
+		FrameHashMap<int, String> map;
+		for (int i = 0; i < 1000; i++) {
+			map.insert(i, itos(i));
+		}
+		CHECK(map.size() == 1000);
+		CHECK(map[500] == "500");
+
+		map.erase(500);
+		CHECK(!map.has(500));
+		CHECK(map[999] == "999");
+	}
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+} // namespace TestFrameArena
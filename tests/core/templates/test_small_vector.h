@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_small_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/small_vector.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallVector {
+
+TEST_CASE("[SmallVector] Inline storage") {
+	SmallVector<int, 4> vector;
+	CHECK(vector.is_empty());
+	CHECK(vector.is_inline());
+
+	vector.push_back(1);
+	vector.push_back(2);
+	vector.push_back(3);
+	vector.push_back(4);
+	CHECK(vector.size() == 4);
+	CHECK(vector.is_inline());
+	CHECK(vector[0] == 1);
+	CHECK(vector[3] == 4);
+
+	vector.set(1, 20);
+	CHECK(vector.get(1) == 20);
+
+	const Vector<int> converted = vector;
+	CHECK(converted == Vector<int>({ 1, 20, 3, 4 }));
+
+#ifdef DEBUG_ENABLED
+	const uint64_t allocs_before = Memory::get_alloc_count();
+	SmallVector<int, 4> copy = vector;
+	copy.set(0, 10);
+	CHECK(vector[0] == 1);
+	CHECK(Memory::get_alloc_count() == allocs_before);
+#endif
+}
+
+TEST_CASE("[SmallVector] Growing past the inline capacity") {
+	SmallVector<int, 2> vector = { 1, 2 };
+	CHECK(vector.is_inline());
+
+	vector.push_back(3);
+	CHECK(!vector.is_inline());
+	CHECK(vector.size() == 3);
+	CHECK(vector[0] == 1);
+	CHECK(vector[2] == 3);
+
+	// Copies share the data, and are only duplicated on write.
+	SmallVector<int, 2> copy = vector;
+	CHECK(copy.ptr() == vector.ptr());
+	copy.set(0, 10);
+	CHECK(copy.ptr() != vector.ptr());
+	CHECK(copy[0] == 10);
+	CHECK(vector[0] == 1);
+
+	const Vector<int> converted = vector;
+	CHECK(converted.ptr() == vector.ptr());
+
+	vector.resize(1);
+	CHECK(vector.size() == 1);
+	CHECK(vector[0] == 1);
+
+	vector.clear();
+	CHECK(vector.is_empty());
+	CHECK(vector.is_inline());
+}
+
+TEST_CASE("[SmallVector] Pushing one of its own elements when spilling") {
+	SmallVector<String, 2> vector = { "a", "b" };
+	vector.push_back(vector[0]);
+	CHECK(!vector.is_inline());
+	REQUIRE(vector.size() == 3);
+	CHECK(vector[0] == "a");
+	CHECK(vector[1] == "b");
+	CHECK(vector[2] == "a");
+}
+
+TEST_CASE("[SmallVector] Construction from Vector") {
+	const Vector<String> small = { "a", "b" };
+	const SmallVector<String, 4> from_small = small;
+	CHECK(from_small.is_inline());
+	CHECK(from_small[1] == "b");
+
+	const Vector<String> big = { "a", "b", "c", "d", "e" };
+	const SmallVector<String, 4> from_big = big;
+	CHECK(!from_big.is_inline());
+	CHECK(from_big.ptr() == big.ptr());
+
+	SmallVector<String, 4> resized;
+	resized.resize(3);
+	CHECK(resized.is_inline());
+	CHECK(resized[2].is_empty());
+	resized.resize(6);
+	CHECK(!resized.is_inline());
+	CHECK(resized.size() == 6);
+	resized.resize(2);
+	CHECK(!resized.is_inline());
+	CHECK(resized.size() == 2);
+	resized.resize(0);
+	CHECK(resized.is_inline());
+	resized.push_back("inline");
+	CHECK(resized.is_inline());
+	CHECK(resized[0] == "inline");
+}
+
+#ifdef DEBUG_ENABLED
+// Counts heap allocations instead of timing, which is why it needs the allocation counter of debug builds.
+// Three points is the common size of a triangle or a short polyline.
+TEST_CASE("[SmallVector][Benchmark] Allocations of small arrays" * doctest::skip()) {
+	const int ITERATIONS = 10000;
+	const Vector3 points[3] = { Vector3(1, 2, 3), Vector3(4, 5, 6), Vector3(7, 8, 9) };
+
+	uint64_t allocs_before = Memory::get_alloc_count();
+	for (int i = 0; i < ITERATIONS; i++) {
+		PackedVector3Array array;
+		for (const Vector3 &point : points) {
+			array.push_back(point);
+		}
+	}
+	const double vector_allocs = double(Memory::get_alloc_count() - allocs_before) / ITERATIONS;
+
+	allocs_before = Memory::get_alloc_count();
+	for (int i = 0; i < ITERATIONS; i++) {
+		SmallVector<Vector3, 4> array;
+		for (const Vector3 &point : points) {
+			array.push_back(point);
+		}
+	}
+	const double small_vector_allocs = double(Memory::get_alloc_count() - allocs_before) / ITERATIONS;
+
+	PackedVector3Array array;
+	for (const Vector3 &point : points) {
+		array.push_back(point);
+	}
+	allocs_before = Memory::get_alloc_count();
+	for (int i = 0; i < ITERATIONS; i++) {
+		const Variant variant = array;
+		const PackedVector3Array round_trip = variant;
+		CHECK(round_trip.size() == 3);
+	}
+	const double variant_allocs = double(Memory::get_alloc_count() - allocs_before) / ITERATIONS;
+
+	print_line(vformat("Allocations per 3-element array: PackedVector3Array %.2f, SmallVector %.2f. Variant round-trip of a PackedVector3Array: %.2f.", vector_allocs, small_vector_allocs, variant_allocs));
+}
+#endif
+
+} // namespace TestSmallVector
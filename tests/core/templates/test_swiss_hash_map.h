@@ -0,0 +1,251 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] List initialization") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[SwissHashMap] Insert, get and erase") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+	CHECK(map.getptr(42) != nullptr);
+
+	map.insert(42, 168);
+	CHECK(map.size() == 1);
+	CHECK(map.get(42) == 168);
+
+	CHECK(map.erase(42));
+	CHECK(!map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(map.getptr(42) == nullptr);
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Grow and erase many elements") {
+	const int count = 10000;
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < count; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == count);
+	CHECK(map.get_capacity() >= uint32_t(count));
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		const int *value = map.getptr(i);
+		all_found = all_found && value != nullptr && *value == i * 2;
+	}
+	CHECK(all_found);
+
+	for (int i = 0; i < count; i += 2) {
+		map.erase(i);
+	}
+	CHECK(map.size() == count / 2);
+
+	bool erased_correctly = true;
+	for (int i = 0; i < count; i++) {
+		erased_correctly = erased_correctly && map.has(i) == (i % 2 == 1);
+	}
+	CHECK(erased_correctly);
+
+	// Elements stay packed, and their indices follow lookups.
+	bool indices_match = true;
+	for (uint32_t i = 0; i < map.size(); i++) {
+		const KeyValue<int, int> &element = map.get_by_index(i);
+		indices_match = indices_match && map.get_index(element.key) == int(i) && element.value == element.key * 2;
+	}
+	CHECK(indices_match);
+}
+
+TEST_CASE("[SwissHashMap] Reuse deleted slots without growing") {
+	SwissHashMap<int, int> map;
+	map.reserve(100);
+	const uint32_t capacity = map.get_capacity();
+
+	// Churn through many more keys than the map can hold at once.
+	for (int i = 0; i < 10000; i++) {
+		map.insert(i, i);
+		if (i >= 50) {
+			map.erase(i - 50);
+		}
+	}
+	CHECK(map.size() == 50);
+	CHECK(map.get_capacity() == capacity);
+
+	bool all_found = true;
+	for (int i = 10000 - 50; i < 10000; i++) {
+		all_found = all_found && map.has(i);
+	}
+	CHECK(all_found);
+	CHECK(!map.has(10000 - 51));
+}
+
+TEST_CASE("[SwissHashMap] String keys") {
+	SwissHashMap<String, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(itos(i), i);
+	}
+	CHECK(map.size() == 1000);
+	CHECK(map["500"] == 500);
+	CHECK(!map.has("1000"));
+
+	CHECK(map.replace_key("500", "five hundred"));
+	CHECK(!map.has("500"));
+	CHECK(map["five hundred"] == 500);
+	CHECK(map.size() == 1000);
+}
+
+TEST_CASE("[SwissHashMap] Copy, move and clear") {
+	SwissHashMap<int, String> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, itos(i));
+	}
+
+	SwissHashMap<int, String> copy = map;
+	CHECK(copy.size() == 100);
+	CHECK(copy[99] == "99");
+	copy.erase(99);
+	CHECK(map.has(99));
+
+	SwissHashMap<int, String> moved = std::move(copy);
+	CHECK(moved.size() == 99);
+	CHECK(copy.is_empty());
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(0));
+	map.insert(0, "0");
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[SwissHashMap] Iteration") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123, 111111);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		idx++;
+	}
+	CHECK(idx == 3);
+}
+
+#ifdef DEBUG_ENABLED
+template <typename TMap, typename TKey>
+static void benchmark_map(const char *p_name, const Vector<TKey> &p_keys) {
+	const int count = p_keys.size();
+	TMap map;
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		map.insert(p_keys[i], i);
+	}
+	const uint64_t insert_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	int found = 0;
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < 4; pass++) {
+		for (int i = 0; i < count; i++) {
+			found += map.has(p_keys[i]);
+		}
+	}
+	const uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - start;
+	CHECK(found == count * 4);
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		map.erase(p_keys[i]);
+	}
+	const uint64_t erase_usec = OS::get_singleton()->get_ticks_usec() - start;
+	CHECK(map.is_empty());
+
+	print_line(vformat("%s: %d inserts %d usec, %d lookups %d usec, %d erases %d usec.", p_name, count, insert_usec, count * 4, lookup_usec, count, erase_usec));
+}
+
+// Keys are spread by a prime stride so they don't land in consecutive buckets of the hash of an integer.
+TEST_CASE("[SwissHashMap][Benchmark] Integer keys compared to HashMap and AHashMap" * doctest::skip()) {
+	Vector<int64_t> keys;
+	for (int i = 0; i < 1000000; i++) {
+		keys.push_back(int64_t(i) * 7919);
+	}
+
+	benchmark_map<HashMap<int64_t, int>>("HashMap", keys);
+	benchmark_map<AHashMap<int64_t, int>>("AHashMap", keys);
+	benchmark_map<SwissHashMap<int64_t, int>>("SwissHashMap", keys);
+}
+
+// Path-like strings with a shared prefix, where comparing full keys is expensive and the control byte
+// filter saves the most.
+TEST_CASE("[SwissHashMap][Benchmark] String keys compared to HashMap and AHashMap" * doctest::skip()) {
+	Vector<String> keys;
+	for (int i = 0; i < 200000; i++) {
+		keys.push_back("res://assets/node_" + itos(i));
+	}
+
+	benchmark_map<HashMap<String, int>>("HashMap", keys);
+	benchmark_map<AHashMap<String, int>>("AHashMap", keys);
+	benchmark_map<SwissHashMap<String, int>>("SwissHashMap", keys);
+}
+#endif
+
+} // namespace TestSwissHashMap
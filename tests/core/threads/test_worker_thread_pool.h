@@ -172,4 +172,139 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static const uint32_t DAG_STAGE_RUNS = 32;
+static SafeNumeric<uint32_t> dag_stage_runs[3];
+static SafeFlag dag_out_of_order;
+
+static void static_dag_stage(uint64_t p_stage) {
+	if (p_stage > 0 && dag_stage_runs[p_stage - 1].get() != DAG_STAGE_RUNS) {
+		dag_out_of_order.set();
+	}
+	dag_stage_runs[p_stage].increment();
+}
+static void static_dag_task(void *p_arg) {
+	static_dag_stage((uint64_t)p_arg);
+}
+static void static_dag_group_task(void *p_arg, uint32_t p_index) {
+	static_dag_stage((uint64_t)p_arg);
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks and group tasks after their predecessors") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const bool low_priority = Math::rand() % 2;
+
+		dag_out_of_order.clear();
+		for (SafeNumeric<uint32_t> &runs : dag_stage_runs) {
+			runs.set(0);
+		}
+
+		// Group -> many tasks -> group, without waiting in between.
+		WorkerThreadPool::GroupID first = pool->add_native_group_task(static_dag_group_task, (void *)0, DAG_STAGE_RUNS, -1, !low_priority);
+		LocalVector<WorkerThreadPool::TaskID> middle;
+		for (uint32_t i = 0; i < DAG_STAGE_RUNS; i++) {
+			middle.push_back(pool->add_native_task_after(Span(&first, 1), static_dag_task, (void *)1, low_priority));
+		}
+		WorkerThreadPool::GroupID last = pool->add_native_group_task_after(middle, static_dag_group_task, (void *)2, DAG_STAGE_RUNS, -1, !low_priority);
+
+		pool->wait_for_group_task_completion(last);
+		CHECK(!dag_out_of_order.is_set());
+		CHECK(dag_stage_runs[2].get() == DAG_STAGE_RUNS);
+
+		for (WorkerThreadPool::TaskID id : middle) {
+			CHECK(pool->is_task_completed(id));
+			pool->wait_for_task_completion(id);
+		}
+		pool->wait_for_group_task_completion(first);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Predecessors already completed or invalid") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	counter.clear();
+	counter.resize(1);
+
+	// A predecessor already awaited is no longer known, but counts as completed.
+	WorkerThreadPool::TaskID done = pool->add_native_task(static_test, (void *)0, true);
+	pool->wait_for_task_completion(done);
+	WorkerThreadPool::TaskID after_done = pool->add_native_task_after(Span(&done, 1), static_test, (void *)0, true);
+	pool->wait_for_task_completion(after_done);
+	CHECK(counter[0].get() == 6);
+
+	// A group without elements completes as soon as its predecessors do.
+	WorkerThreadPool::TaskID first = pool->add_native_task(static_test, (void *)0, true);
+	WorkerThreadPool::GroupID empty = pool->add_native_group_task_after(Span(&first, 1), static_group_test, nullptr, 0);
+	pool->wait_for_group_task_completion(empty);
+	CHECK(pool->is_task_completed(first));
+	pool->wait_for_task_completion(first);
+
+	ERR_PRINT_OFF;
+	const WorkerThreadPool::TaskID invalid = INT32_MAX;
+	CHECK(pool->add_native_task_after(Span(&invalid, 1), static_test, (void *)0) == WorkerThreadPool::INVALID_TASK_ID);
+	CHECK(pool->add_native_group_task_after(Span(&invalid, 1), static_group_test, nullptr, 1) == WorkerThreadPool::INVALID_TASK_ID);
+	ERR_PRINT_ON;
+}
+
+static SafeNumeric<uint64_t> benchmark_counter;
+
+static void static_benchmark_task(void *p_arg) {
+	benchmark_counter.increment();
+}
+
+static void static_benchmark_group_task(void *p_arg, uint32_t p_index) {
+	benchmark_counter.increment();
+}
+
+// Doubles the pool size up to the processor count. Posting tasks from the main thread only fills its own queue,
+// so the task rate depends on how fast idle workers steal from it.
+TEST_CASE("[WorkerThreadPool][Benchmark] Task throughput and group fan-out latency" * doctest::skip()) {
+	const int TASK_COUNT = 20000;
+	const int GROUP_COUNT = 2000;
+	const int ELEMENTS_PER_THREAD = 16;
+
+	const int max_threads = MAX(1, OS::get_singleton()->get_processor_count());
+	for (int thread_count = 1;; thread_count = MIN(thread_count * 2, max_threads)) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		// Individual tasks, posted in bulk, then awaited.
+		LocalVector<WorkerThreadPool::TaskID> task_ids;
+		task_ids.resize(TASK_COUNT);
+		benchmark_counter.set(0);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < TASK_COUNT; i++) {
+			task_ids[i] = pool->add_native_task(static_benchmark_task, nullptr, true);
+		}
+		for (int i = 0; i < TASK_COUNT; i++) {
+			pool->wait_for_task_completion(task_ids[i]);
+		}
+		const uint64_t tasks_usec = MAX((uint64_t)1, OS::get_singleton()->get_ticks_usec() - begin);
+		CHECK(benchmark_counter.get() == TASK_COUNT);
+
+		// Group tasks, each one fanned out to every thread and awaited right away,
+		// which is what physics, culling and navigation do every frame.
+		const int elements = thread_count * ELEMENTS_PER_THREAD;
+		benchmark_counter.set(0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < GROUP_COUNT; i++) {
+			WorkerThreadPool::GroupID group_id = pool->add_native_group_task(static_benchmark_group_task, nullptr, elements, -1, true);
+			pool->wait_for_group_task_completion(group_id);
+		}
+		const uint64_t groups_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(benchmark_counter.get() == (uint64_t)GROUP_COUNT * elements);
+
+		const int64_t tasks_per_second = (uint64_t)TASK_COUNT * 1000000 / tasks_usec;
+		const double usec_per_group = (double)groups_usec / GROUP_COUNT;
+		print_line(vformat("%d threads: %d tasks/s, %.2f usec per group of %d elements.", thread_count, tasks_per_second, usec_per_group, elements));
+
+		memdelete(pool);
+
+		if (thread_count == max_threads) {
+			break;
+		}
+	}
+}
+
 } // namespace TestWorkerThreadPool
@@ -0,0 +1,193 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/physics_3d/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// Static boxes and spheres scattered in a volume, half of them on a second collision layer.
+struct RayTargets {
+	PhysicsServer3D *server = nullptr;
+	RID space;
+	RID box_shape;
+	RID sphere_shape;
+	LocalVector<RID> bodies;
+
+	RayTargets(PhysicsServer3D *p_server) {
+		server = p_server;
+		space = server->space_create();
+
+		box_shape = server->box_shape_create();
+		server->shape_set_data(box_shape, Vector3(0.5, 0.75, 1.0));
+		sphere_shape = server->sphere_shape_create();
+		server->shape_set_data(sphere_shape, 0.6);
+
+		RandomPCG rng(4321);
+		for (int i = 0; i < 64; i++) {
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			server->body_add_shape(body, i % 2 ? box_shape : sphere_shape);
+			server->body_set_collision_layer(body, i % 4 < 2 ? 1 : 2);
+			const Vector3 euler(rng.random(-Math::PI, Math::PI), rng.random(-Math::PI, Math::PI), rng.random(-Math::PI, Math::PI));
+			const Vector3 origin(rng.random(-20.0, 20.0), rng.random(-5.0, 5.0), rng.random(-20.0, 20.0));
+			server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis::from_euler(euler), origin));
+			server->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+
+	~RayTargets() {
+		for (const RID &body : bodies) {
+			server->free_rid(body);
+		}
+		server->free_rid(box_shape);
+		server->free_rid(sphere_shape);
+		server->free_rid(space);
+	}
+};
+
+// Rays of a few agents fanning out in all directions, interleaved with rays cast from anywhere.
+struct RayBatchInput {
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	LocalVector<uint32_t> collision_masks;
+
+	RayBatchInput() {
+		RandomPCG rng(8765);
+		Vector3 agents[4];
+		for (Vector3 &agent : agents) {
+			agent = Vector3(rng.random(-20.0, 20.0), 0, rng.random(-20.0, 20.0));
+		}
+		for (int i = 0; i < 400; i++) {
+			const Vector3 origin = i % 3 == 0 ? Vector3(rng.random(-25.0, 25.0), rng.random(-6.0, 6.0), rng.random(-25.0, 25.0)) : agents[i % 4];
+			const Vector3 direction = Vector3(rng.random(-1.0, 1.0), rng.random(-0.3, 0.3), rng.random(-1.0, 1.0)).normalized();
+			from.push_back(origin);
+			to.push_back(origin + direction * rng.random(5.0, 30.0));
+			collision_masks.push_back(i % 5 == 0 ? 2 : UINT32_MAX);
+		}
+	}
+};
+
+struct RayBatchCall {
+	PhysicsDirectSpaceState3D *state = nullptr;
+	const PhysicsDirectSpaceState3D::RayParameters *parameters = nullptr;
+	const RayBatchInput *input = nullptr;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	LocalVector<bool> hits;
+	int hit_count = 0;
+
+	void run() {
+		results.resize(input->from.size());
+		hits.resize(input->from.size());
+		hit_count = state->intersect_ray_batch(*parameters, input->from.ptr(), input->to.ptr(), input->collision_masks.ptr(), input->from.size(), results.ptr(), hits.ptr());
+	}
+};
+
+static void run_ray_batch_task(void *p_call) {
+	static_cast<RayBatchCall *>(p_call)->run();
+}
+
+// Counts the rays whose batch result differs from casting them one at a time.
+static int count_ray_batch_mismatches(PhysicsDirectSpaceState3D *p_state, const RayBatchInput &p_input, const RayBatchCall &p_call) {
+	int mismatches = 0;
+	for (uint32_t i = 0; i < p_input.from.size(); i++) {
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		parameters.from = p_input.from[i];
+		parameters.to = p_input.to[i];
+		parameters.collision_mask = p_input.collision_masks[i];
+		PhysicsDirectSpaceState3D::RayResult expected;
+		const bool hit = p_state->intersect_ray(parameters, expected);
+
+		const PhysicsDirectSpaceState3D::RayResult &result = p_call.results[i];
+		if (hit != p_call.hits[i]) {
+			mismatches++;
+		} else if (hit && (result.rid != expected.rid || result.shape != expected.shape || !result.position.is_equal_approx(expected.position) || !result.normal.is_equal_approx(expected.normal))) {
+			mismatches++;
+		}
+	}
+	return mismatches;
+}
+
+TEST_CASE("[PhysicsServer3D] Batched rays hit the same as single rays") {
+	const RayBatchInput input;
+
+	// Every backend that is built in, such as Godot Physics and Jolt Physics.
+	for (int server_index = 0; server_index < PhysicsServer3DManager::get_singleton()->get_servers_count(); server_index++) {
+		const String server_name = PhysicsServer3DManager::get_singleton()->get_server_name(server_index);
+		if (server_name == "Dummy") {
+			continue;
+		}
+		PhysicsServer3D *server = PhysicsServer3DManager::get_singleton()->new_server(server_name);
+		REQUIRE(server != nullptr);
+		server->init();
+		INFO(server_name);
+
+		{
+			RayTargets targets(server);
+			PhysicsDirectSpaceState3D *state = server->space_get_direct_state(targets.space);
+			REQUIRE(state != nullptr);
+
+			const PhysicsDirectSpaceState3D::RayParameters parameters;
+			RayBatchCall call;
+			call.state = state;
+			call.parameters = &parameters;
+			call.input = &input;
+
+			call.run();
+			int hits = 0;
+			for (bool hit : call.hits) {
+				hits += hit ? 1 : 0;
+			}
+			CHECK_MESSAGE(call.hit_count == hits, "The returned hit count should match the hits.");
+			CHECK_MESSAGE(call.hit_count > 0, "Some of the rays should hit.");
+			CHECK_MESSAGE(call.hit_count < (int)input.from.size(), "Some of the rays should miss.");
+			CHECK_MESSAGE(count_ray_batch_mismatches(state, input, call) == 0, "Each ray of the batch should hit the same as when cast alone.");
+
+			// Like AI jobs, which cast the rays from a WorkerThreadPool task.
+			RayBatchCall task_call = call;
+			task_call.results.clear();
+			task_call.hits.clear();
+			const WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&run_ray_batch_task, &task_call);
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+			CHECK_MESSAGE(count_ray_batch_mismatches(state, input, task_call) == 0, "A batch cast from a task should hit the same as when cast alone.");
+		}
+
+		server->finish();
+		memdelete(server);
+	}
+}
+
+} // namespace TestPhysicsServer3D